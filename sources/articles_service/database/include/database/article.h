@@ -4,11 +4,14 @@
 #include <Poco/JSON/Object.h>
 #include <string>
 #include <optional>
+#include <vector>
 
 namespace database {
 
     class Article {
         friend class Database;
+        friend class MySqlArticleStorage;
+        friend class MemoryArticleStorage;
     public:
         static Article FromJSON(const std::string & str);
 
@@ -30,12 +33,22 @@ namespace database {
         static void Init();
 
         static std::optional<Article> SearchByID(long id);
+        static std::vector<Article> SearchByIDs(const std::vector<long>& ids, const std::vector<std::string>& fields);
+        static bool IsProjectableField(const std::string& field);
         static std::vector<long> ReadAll();
         static bool DeleteByID(long id);
+        static bool Exists(long id);
+
+        static std::optional<Article> FromCacheByID(long id);
+        void SaveToCache() const;
 
         void InsertToDatabase();
 
         [[nodiscard]] Poco::JSON::Object::Ptr ToJSON() const;
+        [[nodiscard]] Poco::JSON::Object::Ptr ToJSON(const std::vector<std::string>& fields) const;
+
+        [[nodiscard]] std::string Serialize() const;
+        void Deserialize(const std::string& serialized);
 
     private:
         long id_{ -1 };
@@ -0,0 +1,37 @@
+#ifndef SERVER_DATABASE_ARTICLE_INDEX_H
+#define SERVER_DATABASE_ARTICLE_INDEX_H
+
+#include <cstdint>
+#include <shared_mutex>
+#include <vector>
+
+namespace database {
+
+    /**
+     * @brief Битовая карта существующих id статей в памяти.
+     * @details Id статей выдаются AUTO_INCREMENT и идут плотно, поэтому бит на id
+     * дает точный ответ без ложных срабатываний при ~125 КБ на миллион статей.
+     * Заполняется при старте сервиса и обновляется при вставке и удалении.
+     */
+    class ArticleIndex {
+        ArticleIndex() = default;
+
+    public:
+        static ArticleIndex& Instance();
+
+        void Load(const std::vector<long>& ids);
+        void Add(long id);
+        void Remove(long id);
+
+        [[nodiscard]] bool Contains(long id) const;
+        [[nodiscard]] size_t Size() const;
+
+    private:
+        mutable std::shared_mutex mtx_;
+        std::vector<uint64_t> bits_;
+        size_t size_{ 0 };
+    };
+
+} // namespace database
+
+#endif //SERVER_DATABASE_ARTICLE_INDEX_H
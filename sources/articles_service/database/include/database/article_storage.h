@@ -0,0 +1,79 @@
+#ifndef SERVER_DATABASE_ARTICLE_STORAGE_H
+#define SERVER_DATABASE_ARTICLE_STORAGE_H
+
+#include "article.h"
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace database {
+
+    /**
+     * @brief Хранилище статей, на которое опираются статические методы Article.
+     * @details Реализация выбирается один раз при старте сервиса, до приема запросов.
+     * Кэш и индекс id остаются в Article и не зависят от хранилища.
+     */
+    class ArticleStorage {
+    public:
+        virtual ~ArticleStorage() = default;
+
+        static ArticleStorage& Instance();
+
+        /* Подмена хранилища, по умолчанию используется MySqlArticleStorage */
+        static void Use(std::unique_ptr<ArticleStorage> storage);
+
+        virtual void Init() = 0;
+
+        virtual std::vector<long> ReadAll() = 0;
+        virtual std::optional<Article> SearchByID(long id) = 0;
+        virtual std::vector<Article> SearchByIDs(const std::vector<long>& ids, const std::vector<std::string>& fields) = 0;
+        virtual bool Exists(long id) = 0;
+        virtual bool DeleteByID(long id) = 0;
+
+        /* Проставляет статье id и дату создания */
+        virtual void Insert(Article& article) = 0;
+    };
+
+    class MySqlArticleStorage : public ArticleStorage {
+    public:
+        void Init() override;
+
+        std::vector<long> ReadAll() override;
+        std::optional<Article> SearchByID(long id) override;
+        std::vector<Article> SearchByIDs(const std::vector<long>& ids, const std::vector<std::string>& fields) override;
+        bool Exists(long id) override;
+        bool DeleteByID(long id) override;
+
+        void Insert(Article& article) override;
+    };
+
+    /**
+     * @brief Хранилище в памяти процесса для запуска сервиса без БД.
+     * @details id выдаются с единицы, как AUTO_INCREMENT. Чтения идут под разделяемой
+     * блокировкой и не мешают друг другу.
+     */
+    class MemoryArticleStorage : public ArticleStorage {
+    public:
+        void Init() override;
+
+        std::vector<long> ReadAll() override;
+        std::optional<Article> SearchByID(long id) override;
+        std::vector<Article> SearchByIDs(const std::vector<long>& ids, const std::vector<std::string>& fields) override;
+        bool Exists(long id) override;
+        bool DeleteByID(long id) override;
+
+        void Insert(Article& article) override;
+
+    private:
+        mutable std::shared_mutex mtx_;
+        long next_id_{ 1 };
+        std::map<long, Article> rows_;
+    };
+
+} // namespace database
+
+#endif //SERVER_DATABASE_ARTICLE_STORAGE_H
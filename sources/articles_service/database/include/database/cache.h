@@ -0,0 +1,43 @@
+#ifndef SERVER_CACHE_H
+#define SERVER_CACHE_H
+
+#include <memory>
+#include <string>
+
+#include "article.h"
+#include "cache_backend.h"
+
+namespace database
+{
+    /**
+     * @brief Кэш статей по схеме cache-aside поверх CacheBackend (Redis или память процесса).
+     * @details Сериализованная статья длиннее порога сжимается zlib: поля content
+     * и description составляют основной объём записи. Ошибки хранилища не прерывают
+     * запрос - кэш считается промахнувшимся.
+     */
+    class Cache
+    {
+        Cache();
+
+    public:
+        static Cache* Get();
+        void Init(std::unique_ptr<search_service::CacheBackend> backend, unsigned int expiration = 60,
+                  unsigned int compress_min_size = 1024);
+
+        void Put(const Article& article);
+        bool Get(long id, Article& article);
+        void Remove(long id);
+
+        [[nodiscard]] bool IsInited() const noexcept;
+
+    private:
+        std::unique_ptr<search_service::CacheBackend> _backend;
+        unsigned int _expiration;
+        unsigned int _compress_min_size;
+        bool _is_inited;
+    };
+
+} // namespace database
+
+
+#endif //SERVER_CACHE_H
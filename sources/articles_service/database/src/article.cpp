@@ -1,46 +1,26 @@
 #include "database/article.h"
 
-#include "database/database.h"
+#include "database/article_storage.h"
+#include "database/cache.h"
+#include "database/article_index.h"
+#include "invalidation_bus.h"
 
-#include <Poco/Data/MySQL/Connector.h>
-#include <Poco/Data/MySQL/MySQLException.h>
-#include <Poco/Data/SessionFactory.h>
 #include <Poco/JSON/Parser.h>
 #include <Poco/Dynamic/Var.h>
 
-using namespace Poco::Data::Keywords;
-using Poco::Data::Session;
-using Poco::Data::Statement;
-
-#define TABLE_NAME "Articles"
-#define CREATE_TABLE_REQUEST                                        \
-    "CREATE TABLE IF NOT EXISTS `" TABLE_NAME "` "                  \
-    "("                                                             \
-        "`id` " "INT " "NOT NULL " "AUTO_INCREMENT, "               \
-        "`consumer_id` " "INT " "NOT NULL, "                        \
-        "`title` " "VARCHAR(256) " "NOT NULL, "                     \
-        "`description` " "TEXT " "NOT NULL, "                       \
-        "`content` " "TEXT " "NOT NULL, "                           \
-        "`external_link` " "TEXT " "NULL, "                         \
-        "`create_date` " "DATETIME " "DEFAULT CURRENT_TIMESTAMP, "  \
-        "PRIMARY KEY (`id`)"                                        \
-    ");"
-
-#define SELECT_ALL_ID_REQUEST \
-    "SELECT id FROM " TABLE_NAME
-
-#define SELECT_BY_ID_REQUEST                                                                    \
-    "SELECT id, consumer_id, title, description, content, external_link, create_date FROM "     \
-    TABLE_NAME                                                                                  \
-    " WHERE id=?"
-
-#define INSERT_ARTICLE_REQUEST \
-    "INSERT INTO " TABLE_NAME " " \
-    "(consumer_id, title, description, content, external_link) " \
-    "VALUES(?, ?, ?, ?, ?)"
-
-#define DELETE_BY_ID_REQUEST \
-    "DELETE FROM " TABLE_NAME " WHERE id=?"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+namespace {
+
+    /* Колонки, которые можно запросить в пакетной выборке */
+    const char* const kProjectableFields[] = {
+            "id", "consumer_id", "title", "description", "content", "external_link", "create_date"
+    };
+
+} // namespace [ Constants ]
 
 namespace database {
 
@@ -77,153 +57,80 @@ namespace database {
     std::string &Article::ExternalLink() noexcept { return external_link_; }
 
     void Article::Init() {
-        try {
-            Poco::Data::Session session = database::Database::Instance().CreateSession();
-            Statement create_statement(session);
-
-            create_statement << CREATE_TABLE_REQUEST, now;
-        } catch (Poco::Data::MySQL::ConnectionException& e) {
-            std::cerr << "Connection to database failed: " << e.what() << std::endl;
-            throw;
-        } catch (Poco::Data::MySQL::StatementException &e) {
-            std::cerr << "Statement exception: " << e.what() << std::endl;
-            throw;
-        }
+        ArticleStorage::Instance().Init();
     }
 
     std::vector<long> Article::ReadAll() {
-        try
-        {
-            Poco::Data::Session session = database::Database::Instance().CreateSession();
-            Statement select(session);
-            std::vector<long> result;
-
-            long id;
-            select << SELECT_ALL_ID_REQUEST,
-                    into(id),
-                    range(0, 1); //  iterate over result set one row at a time
-
-            while (!select.done()) {
-                if (select.execute()) {
-                    result.push_back(id);
-                }
-            }
-
-            return result;
-        }
-        catch (Poco::Data::MySQL::ConnectionException &e) {
-            std::cerr << "Connection to DB error: " << e.what() << std::endl;
-            throw;
-        }
-        catch (Poco::Data::MySQL::StatementException &e) {
-            std::cerr << "Statement error: " << e.what() << std::endl;
-            throw;
-        }
+        return ArticleStorage::Instance().ReadAll();
     }
 
     std::optional<Article> Article::SearchByID(long id) {
-        try {
-            Poco::Data::Session session = database::Database::Instance().CreateSession();
-            Statement select(session);
-
-            Article article;
-
-            Poco::DateTime create_date;
-            select << SELECT_BY_ID_REQUEST,
-                    into(article.id_),
-                    into(article.consumer_id_),
-                    into(article.title_),
-                    into(article.description_),
-                    into(article.content_),
-                    into(article.external_link_),
-                    into(create_date),
-                    use(id);
-
-            size_t selected_rows = select.execute();
-
-            Poco::DateTimeFormatter formatter;
-            article.create_date_ = formatter.format(create_date, "%f %b %Y, %H:%M:%S");
-
-            if ( selected_rows > 0 ) {
-                return article;
-            }
+        return ArticleStorage::Instance().SearchByID(id);
+    }
 
-            return { };
-        }
+    bool Article::IsProjectableField(const std::string& field) {
+        return std::find(std::begin(kProjectableFields), std::end(kProjectableFields), field) != std::end(kProjectableFields);
+    }
 
-        catch (Poco::Data::MySQL::ConnectionException &e) {
-            std::cerr << "Connection to DB error: " << e.what() << std::endl;
-            throw;
-        }
-        catch (Poco::Data::MySQL::StatementException &e) {
-            std::cerr << "Statement error: " << e.what() << std::endl;
-            throw;
-        }
+    /**
+     * @brief Статьи по списку id одним запросом с выборкой только нужных колонок.
+     * @details Колонка id читается всегда. Незапрошенные поля остаются пустыми.
+     * Порядок результата не определен.
+     */
+    std::vector<Article> Article::SearchByIDs(const std::vector<long>& ids, const std::vector<std::string>& fields) {
+        if ( ids.empty() ) return { };
+        return ArticleStorage::Instance().SearchByIDs(ids, fields);
     }
 
     bool Article::DeleteByID(long id) {
-        try {
-            Poco::Data::Session session = database::Database::Instance().CreateSession();
-            Statement delete_stm(session);
-
-            delete_stm << DELETE_BY_ID_REQUEST, use(id);
+        if ( !ArticleStorage::Instance().DeleteByID(id) ) {
+            return false;
+        }
 
-            size_t deleted_rows = delete_stm.execute();
+        ArticleIndex::Instance().Remove(id);
+        Cache::Get()->Remove(id);
+        search_service::InvalidationBus::Get()->Publish(id);
+        return true;
+    }
 
-            if ( deleted_rows > 0 ) {
-                return true;
-            }
+    /**
+     * @brief Проверка существования статьи.
+     * @details Ответ берется из битовой карты id. Отсутствие в карте перепроверяется
+     * в хранилище: статью мог вставить другой экземпляр сервиса. Удаления на других
+     * экземплярах снимают бит через InvalidationBus.
+     */
+    bool Article::Exists(long id) {
+        if ( ArticleIndex::Instance().Contains(id) ) {
+            return true;
+        }
 
+        if ( !ArticleStorage::Instance().Exists(id) ) {
             return false;
         }
 
-        catch (Poco::Data::MySQL::ConnectionException &e) {
-            std::cerr << "Connection to DB error: " << e.what() << std::endl;
-            throw;
-        }
-        catch (Poco::Data::MySQL::StatementException &e) {
-            std::cerr << "Statement error: " << e.what() << std::endl;
-            throw;
-        }
+        ArticleIndex::Instance().Add(id);
+        return true;
     }
 
     void Article::InsertToDatabase() {
-        try
-        {
-            Poco::Data::Session session = database::Database::Instance().CreateSession();
-            Poco::Data::Statement insert(session);
-
-            insert << INSERT_ARTICLE_REQUEST,
-                    use(consumer_id_),
-                    use(title_),
-                    use(description_),
-                    use(content_),
-                    use(external_link_);
-
-            insert.execute();
-
-            Poco::Data::Statement select(session);
-            select << "SELECT LAST_INSERT_ID()",
-                    into(id_),
-                    range(0, 1); //  iterate over result set one row at a time
-
-            if (!select.done()) {
-                select.execute();
-            }
+        ArticleStorage::Instance().Insert(*this);
 
-            std::cout << "Inserted to DB: " << id_ << std::endl;
-        }
-        catch (Poco::Data::MySQL::ConnectionException &e)
-        {
-            std::cerr << "Connection to DB error: " << e.what() << std::endl;
-            throw;
-        }
-        catch (Poco::Data::MySQL::StatementException &e)
-        {
+        std::cout << "Inserted to DB: " << id_ << std::endl;
+        ArticleIndex::Instance().Add(id_);
+        SaveToCache();
+    }
 
-            std::cerr << "Statement error: " << e.what() << std::endl;
-            throw;
+    std::optional<Article> Article::FromCacheByID(long id) {
+        Article article;
+        if ( Cache::Get()->Get(id, article) ) {
+            return article;
         }
+        return { };
+    }
+
+    void Article::SaveToCache() const {
+        if ( id_ == -1 ) return;
+        Cache::Get()->Put(*this);
     }
 
     Poco::JSON::Object::Ptr Article::ToJSON() const {
@@ -241,4 +148,40 @@ namespace database {
         return root;
     }
 
-} // namespace database
\ No newline at end of file
+    Poco::JSON::Object::Ptr Article::ToJSON(const std::vector<std::string>& fields) const {
+        Poco::JSON::Object::Ptr full = ToJSON();
+        Poco::JSON::Object::Ptr root = new Poco::JSON::Object();
+
+        root->set("id", id_);
+        for ( const auto& field : fields ) {
+            if ( full->has(field) ) {
+                root->set(field, full->get(field));
+            }
+        }
+
+        return root;
+    }
+
+    std::string Article::Serialize() const {
+        Poco::JSON::Object::Ptr root = ToJSON();
+
+        std::stringstream ss;
+        root->stringify(ss);
+        return ss.str();
+    }
+
+    void Article::Deserialize(const std::string& serialized) {
+        Poco::JSON::Parser parser;
+        Poco::Dynamic::Var result = parser.parse(serialized);
+        Poco::JSON::Object::Ptr object = result.extract<Poco::JSON::Object::Ptr>();
+
+        id_ = object->getValue<long>("id");
+        consumer_id_ = object->getValue<long>("consumer_id");
+        title_ = object->getValue<std::string>("title");
+        description_ = object->getValue<std::string>("description");
+        content_ = object->getValue<std::string>("content");
+        external_link_ = object->has("external_link") ? object->getValue<std::string>("external_link") : std::string();
+        create_date_ = object->getValue<std::string>("create_date");
+    }
+
+} // namespace database
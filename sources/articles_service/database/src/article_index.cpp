@@ -0,0 +1,78 @@
+#include "database/article_index.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace {
+
+    constexpr const size_t kWordBits = 64;
+
+} // namespace [ Constants ]
+
+namespace database {
+
+    ArticleIndex& ArticleIndex::Instance() {
+        static ArticleIndex instance;
+        return instance;
+    }
+
+    void ArticleIndex::Load(const std::vector<long>& ids) {
+        std::vector<uint64_t> bits;
+        size_t size = 0;
+        for ( long id : ids ) {
+            if ( id < 0 ) continue;
+
+            size_t word = static_cast<size_t>(id) / kWordBits;
+            if ( word >= bits.size() ) bits.resize(word + 1, 0);
+
+            uint64_t mask = uint64_t{ 1 } << (static_cast<size_t>(id) % kWordBits);
+            if ( (bits[word] & mask) == 0 ) size++;
+            bits[word] |= mask;
+        }
+
+        std::unique_lock<std::shared_mutex> lck(mtx_);
+        bits_.swap(bits);
+        size_ = size;
+    }
+
+    void ArticleIndex::Add(long id) {
+        if ( id < 0 ) return;
+
+        size_t word = static_cast<size_t>(id) / kWordBits;
+        uint64_t mask = uint64_t{ 1 } << (static_cast<size_t>(id) % kWordBits);
+
+        std::unique_lock<std::shared_mutex> lck(mtx_);
+        /* Запас по росту, чтобы последовательные вставки не перевыделяли память каждый раз */
+        if ( word >= bits_.size() ) bits_.resize(std::max(word + 1, bits_.size() * 2), 0);
+        if ( (bits_[word] & mask) == 0 ) size_++;
+        bits_[word] |= mask;
+    }
+
+    void ArticleIndex::Remove(long id) {
+        if ( id < 0 ) return;
+
+        size_t word = static_cast<size_t>(id) / kWordBits;
+        uint64_t mask = uint64_t{ 1 } << (static_cast<size_t>(id) % kWordBits);
+
+        std::unique_lock<std::shared_mutex> lck(mtx_);
+        if ( word >= bits_.size() ) return;
+        if ( (bits_[word] & mask) != 0 ) size_--;
+        bits_[word] &= ~mask;
+    }
+
+    bool ArticleIndex::Contains(long id) const {
+        if ( id < 0 ) return false;
+
+        size_t word = static_cast<size_t>(id) / kWordBits;
+        uint64_t mask = uint64_t{ 1 } << (static_cast<size_t>(id) % kWordBits);
+
+        std::shared_lock<std::shared_mutex> lck(mtx_);
+        return word < bits_.size() && (bits_[word] & mask) != 0;
+    }
+
+    size_t ArticleIndex::Size() const {
+        std::shared_lock<std::shared_mutex> lck(mtx_);
+        return size_;
+    }
+
+} // namespace database
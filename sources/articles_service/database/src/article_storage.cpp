@@ -0,0 +1,101 @@
+#include "database/article_storage.h"
+
+#include <Poco/DateTime.h>
+#include <Poco/DateTimeFormatter.h>
+
+#include <iostream>
+#include <mutex>
+
+namespace {
+
+    std::unique_ptr<database::ArticleStorage>& CurrentStorage() {
+        static std::unique_ptr<database::ArticleStorage> storage = std::make_unique<database::MySqlArticleStorage>();
+        return storage;
+    }
+
+} // namespace [ Functions ]
+
+namespace database {
+
+    ArticleStorage& ArticleStorage::Instance() {
+        return *CurrentStorage();
+    }
+
+    void ArticleStorage::Use(std::unique_ptr<ArticleStorage> storage) {
+        CurrentStorage() = std::move(storage);
+    }
+
+    void MemoryArticleStorage::Init() {
+        std::cout << "Articles are kept in memory" << std::endl;
+    }
+
+    std::vector<long> MemoryArticleStorage::ReadAll() {
+        std::shared_lock<std::shared_mutex> lck(mtx_);
+
+        std::vector<long> result;
+        result.reserve(rows_.size());
+        for ( const auto& row : rows_ ) {
+            result.push_back(row.first);
+        }
+        return result;
+    }
+
+    std::optional<Article> MemoryArticleStorage::SearchByID(long id) {
+        std::shared_lock<std::shared_mutex> lck(mtx_);
+
+        auto it = rows_.find(id);
+        if ( it == rows_.end() ) return { };
+        return it->second;
+    }
+
+    std::vector<Article> MemoryArticleStorage::SearchByIDs(const std::vector<long>& ids, const std::vector<std::string>& fields) {
+        std::shared_lock<std::shared_mutex> lck(mtx_);
+
+        std::vector<Article> result;
+        for ( long id : ids ) {
+            auto it = rows_.find(id);
+            if ( it == rows_.end() ) continue;
+
+            const Article& stored = it->second;
+            Article article;
+            article.id_ = stored.id_;
+            for ( const auto& field : fields ) {
+                if ( field == "consumer_id" ) {
+                    article.consumer_id_ = stored.consumer_id_;
+                } else if ( field == "title" ) {
+                    article.title_ = stored.title_;
+                } else if ( field == "description" ) {
+                    article.description_ = stored.description_;
+                } else if ( field == "content" ) {
+                    article.content_ = stored.content_;
+                } else if ( field == "external_link" ) {
+                    article.external_link_ = stored.external_link_;
+                } else if ( field == "create_date" ) {
+                    article.create_date_ = stored.create_date_;
+                }
+            }
+            result.push_back(std::move(article));
+        }
+        return result;
+    }
+
+    bool MemoryArticleStorage::Exists(long id) {
+        std::shared_lock<std::shared_mutex> lck(mtx_);
+        return rows_.count(id) > 0;
+    }
+
+    bool MemoryArticleStorage::DeleteByID(long id) {
+        std::unique_lock<std::shared_mutex> lck(mtx_);
+        return rows_.erase(id) > 0;
+    }
+
+    void MemoryArticleStorage::Insert(Article& article) {
+        Poco::DateTimeFormatter formatter;
+        article.create_date_ = formatter.format(Poco::DateTime(), "%f %b %Y, %H:%M:%S");
+
+        std::unique_lock<std::shared_mutex> lck(mtx_);
+        article.id_ = next_id_++;
+        rows_.emplace(article.id_, article);
+    }
+
+} // namespace database
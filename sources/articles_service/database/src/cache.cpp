@@ -0,0 +1,116 @@
+#include "../include/database/cache.h"
+
+#include <Poco/DeflatingStream.h>
+#include <Poco/InflatingStream.h>
+#include <Poco/StreamCopier.h>
+
+#include <exception>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+    constexpr const char* const kKeyPrefix = "article:";
+
+    /* Первый байт значения в Redis: несжатый JSON или JSON, сжатый zlib */
+    constexpr const char kPlainMarker = 'j';
+    constexpr const char kCompressedMarker = 'z';
+
+} // namespace [ Constants ]
+
+namespace {
+
+    std::string MakeKey(long id) {
+        return kKeyPrefix + std::to_string(id);
+    }
+
+    std::string Encode(const std::string& serialized, unsigned int compress_min_size) {
+        if ( serialized.size() < compress_min_size ) {
+            return kPlainMarker + serialized;
+        }
+
+        std::ostringstream compressed;
+        compressed.put(kCompressedMarker);
+
+        Poco::DeflatingOutputStream deflater(compressed, Poco::DeflatingStreamBuf::STREAM_ZLIB);
+        deflater.write(serialized.data(), static_cast<std::streamsize>(serialized.size()));
+        deflater.close();
+
+        return compressed.str();
+    }
+
+    std::string Decode(const std::string& value) {
+        if ( value.empty() ) {
+            throw std::runtime_error("Empty cache value");
+        }
+
+        if ( value.front() == kPlainMarker ) {
+            return value.substr(1);
+        }
+        if ( value.front() != kCompressedMarker ) {
+            throw std::runtime_error("Unknown cache value format");
+        }
+
+        std::istringstream compressed(value.substr(1));
+        Poco::InflatingInputStream inflater(compressed, Poco::InflatingStreamBuf::STREAM_ZLIB);
+
+        std::string serialized;
+        Poco::StreamCopier::copyToString(inflater, serialized);
+        return serialized;
+    }
+
+} // namespace [ Functions ]
+
+namespace database
+{
+    Cache::Cache() :
+        _expiration(60),
+        _compress_min_size(1024),
+        _is_inited(false) {}
+
+    void Cache::Init(std::unique_ptr<search_service::CacheBackend> backend, unsigned int expiration,
+                     unsigned int compress_min_size) {
+        _backend = std::move(backend);
+        _expiration = expiration;
+        _compress_min_size = compress_min_size;
+        _is_inited = _backend != nullptr;
+    }
+
+    Cache* Cache::Get() {
+        static Cache* instance;
+        if ( !instance ) instance = new Cache();
+        return instance;
+    }
+
+    bool Cache::IsInited() const noexcept {
+        return _is_inited;
+    }
+
+    void Cache::Put(const Article& article) {
+        if ( !_is_inited ) return;
+
+        _backend->Set(MakeKey(article.GetID()), Encode(article.Serialize(), _compress_min_size), _expiration);
+    }
+
+    bool Cache::Get(long id, Article& article) {
+        if ( !_is_inited ) return false;
+
+        std::optional<std::string> value = _backend->Get(MakeKey(id));
+        if ( !value.has_value() || value->empty() ) return false;
+
+        try {
+            article.Deserialize(Decode(*value));
+        } catch ( const std::exception& e ) {
+            std::cerr << "Cache value error: " << e.what() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void Cache::Remove(long id) {
+        if ( !_is_inited ) return;
+
+        _backend->Remove(MakeKey(id));
+    }
+
+} // namespace database
@@ -0,0 +1,294 @@
+#include "database/article_storage.h"
+
+#include "database/database.h"
+
+#include <Poco/Data/MySQL/Connector.h>
+#include <Poco/Data/MySQL/MySQLException.h>
+#include <Poco/Data/SessionFactory.h>
+#include <Poco/Data/RecordSet.h>
+#include <Poco/DateTimeFormatter.h>
+
+#include <iostream>
+
+using namespace Poco::Data::Keywords;
+using Poco::Data::Session;
+using Poco::Data::Statement;
+
+#define TABLE_NAME "Articles"
+#define CREATE_TABLE_REQUEST                                        \
+    "CREATE TABLE IF NOT EXISTS `" TABLE_NAME "` "                  \
+    "("                                                             \
+        "`id` " "INT " "NOT NULL " "AUTO_INCREMENT, "               \
+        "`consumer_id` " "INT " "NOT NULL, "                        \
+        "`title` " "VARCHAR(256) " "NOT NULL, "                     \
+        "`description` " "TEXT " "NOT NULL, "                       \
+        "`content` " "TEXT " "NOT NULL, "                           \
+        "`external_link` " "TEXT " "NULL, "                         \
+        "`create_date` " "DATETIME " "DEFAULT CURRENT_TIMESTAMP, "  \
+        "PRIMARY KEY (`id`)"                                        \
+    ");"
+
+#define SELECT_ALL_ID_REQUEST \
+    "SELECT id FROM " TABLE_NAME
+
+#define SELECT_BY_ID_REQUEST                                                                    \
+    "SELECT id, consumer_id, title, description, content, external_link, create_date FROM "     \
+    TABLE_NAME                                                                                  \
+    " WHERE id=?"
+
+#define INSERT_ARTICLE_REQUEST \
+    "INSERT INTO " TABLE_NAME " " \
+    "(consumer_id, title, description, content, external_link) " \
+    "VALUES(?, ?, ?, ?, ?)"
+
+/* Колонки и список id подставляются при сборке запроса: колонки из белого списка, id уже разобраны как long */
+#define SELECT_BY_IDS_REQUEST_FROM \
+    " FROM " TABLE_NAME " WHERE id IN "
+
+#define SELECT_EXISTS_REQUEST \
+    "SELECT id FROM " TABLE_NAME " WHERE id=?"
+
+#define SELECT_INSERTED_REQUEST \
+    "SELECT id, create_date FROM " TABLE_NAME " WHERE id=LAST_INSERT_ID()"
+
+#define DELETE_BY_ID_REQUEST \
+    "DELETE FROM " TABLE_NAME " WHERE id=?"
+
+namespace database {
+
+    void MySqlArticleStorage::Init() {
+        try {
+            Poco::Data::Session session = database::Database::Instance().CreateSession();
+            Statement create_statement(session);
+
+            create_statement << CREATE_TABLE_REQUEST, now;
+        } catch (Poco::Data::MySQL::ConnectionException& e) {
+            std::cerr << "Connection to database failed: " << e.what() << std::endl;
+            throw;
+        } catch (Poco::Data::MySQL::StatementException &e) {
+            std::cerr << "Statement exception: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    std::vector<long> MySqlArticleStorage::ReadAll() {
+        try
+        {
+            Poco::Data::Session session = database::Database::Instance().CreateReadSession();
+            Statement select(session);
+            std::vector<long> result;
+
+            long id;
+            select << SELECT_ALL_ID_REQUEST,
+                    into(id),
+                    range(0, 1); //  iterate over result set one row at a time
+
+            while (!select.done()) {
+                if (select.execute()) {
+                    result.push_back(id);
+                }
+            }
+
+            return result;
+        }
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cerr << "Connection to DB error: " << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cerr << "Statement error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    std::optional<Article> MySqlArticleStorage::SearchByID(long id) {
+        try {
+            Poco::Data::Session session = database::Database::Instance().CreateReadSession();
+            Statement select(session);
+
+            Article article;
+
+            Poco::DateTime create_date;
+            select << SELECT_BY_ID_REQUEST,
+                    into(article.id_),
+                    into(article.consumer_id_),
+                    into(article.title_),
+                    into(article.description_),
+                    into(article.content_),
+                    into(article.external_link_),
+                    into(create_date),
+                    use(id);
+
+            size_t selected_rows = select.execute();
+
+            Poco::DateTimeFormatter formatter;
+            article.create_date_ = formatter.format(create_date, "%f %b %Y, %H:%M:%S");
+
+            if ( selected_rows > 0 ) {
+                return article;
+            }
+
+            return { };
+        }
+
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cerr << "Connection to DB error: " << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cerr << "Statement error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    std::vector<Article> MySqlArticleStorage::SearchByIDs(const std::vector<long>& ids, const std::vector<std::string>& fields) {
+        std::vector<Article> result;
+        if ( ids.empty() ) return result;
+
+        std::string request = "SELECT id";
+        for ( const auto& field : fields ) {
+            if ( field == "id" || !Article::IsProjectableField(field) ) continue;
+            request += ", " + field;
+        }
+        request += SELECT_BY_IDS_REQUEST_FROM "(";
+        for ( size_t i = 0; i < ids.size(); i++ ) {
+            if ( i > 0 ) request += ",";
+            request += std::to_string(ids[i]);
+        }
+        request += ")";
+
+        try {
+            Poco::Data::Session session = database::Database::Instance().CreateReadSession();
+            Statement select(session);
+            select << request;
+            select.execute();
+
+            Poco::Data::RecordSet rows(select);
+            result.resize(rows.rowCount());
+
+            Poco::DateTimeFormatter formatter;
+            for ( size_t column = 0; column < rows.columnCount(); column++ ) {
+                const std::string& name = rows.columnName(column);
+                for ( size_t row = 0; row < rows.rowCount(); row++ ) {
+                    Poco::Dynamic::Var value = rows.value(column, row);
+                    Article& article = result[row];
+
+                    if ( name == "id" ) {
+                        article.id_ = value.convert<long>();
+                    } else if ( name == "consumer_id" ) {
+                        article.consumer_id_ = value.convert<long>();
+                    } else if ( name == "title" ) {
+                        article.title_ = value.convert<std::string>();
+                    } else if ( name == "description" ) {
+                        article.description_ = value.convert<std::string>();
+                    } else if ( name == "content" ) {
+                        article.content_ = value.convert<std::string>();
+                    } else if ( name == "external_link" ) {
+                        article.external_link_ = value.isEmpty() ? std::string() : value.convert<std::string>();
+                    } else if ( name == "create_date" ) {
+                        article.create_date_ = formatter.format(value.convert<Poco::DateTime>(), "%f %b %Y, %H:%M:%S");
+                    }
+                }
+            }
+            return result;
+        }
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cerr << "Connection to DB error: " << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cerr << "Statement error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    bool MySqlArticleStorage::DeleteByID(long id) {
+        try {
+            Poco::Data::Session session = database::Database::Instance().CreateSession();
+            Statement delete_stm(session);
+
+            delete_stm << DELETE_BY_ID_REQUEST, use(id);
+
+            size_t deleted_rows = delete_stm.execute();
+            database::Database::Instance().NoteWrite();
+
+            return deleted_rows > 0;
+        }
+
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cerr << "Connection to DB error: " << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cerr << "Statement error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    bool MySqlArticleStorage::Exists(long id) {
+        try {
+            Poco::Data::Session session = database::Database::Instance().CreateReadSession();
+            Statement select(session);
+
+            long found_id = -1;
+            select << SELECT_EXISTS_REQUEST,
+                    into(found_id),
+                    use(id);
+
+            return select.execute() > 0;
+        }
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cerr << "Connection to DB error: " << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cerr << "Statement error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    void MySqlArticleStorage::Insert(Article& article) {
+        try
+        {
+            Poco::Data::Session session = database::Database::Instance().CreateSession();
+            Poco::Data::Statement insert(session);
+
+            insert << INSERT_ARTICLE_REQUEST,
+                    use(article.consumer_id_),
+                    use(article.title_),
+                    use(article.description_),
+                    use(article.content_),
+                    use(article.external_link_);
+
+            insert.execute();
+            database::Database::Instance().NoteWrite();
+
+            /* Дата создания выставляется сервером БД, она нужна для записи в кэш */
+            Poco::DateTime create_date;
+            Poco::Data::Statement select(session);
+            select << SELECT_INSERTED_REQUEST,
+                    into(article.id_),
+                    into(create_date),
+                    range(0, 1); //  iterate over result set one row at a time
+
+            if (!select.done()) {
+                select.execute();
+            }
+
+            Poco::DateTimeFormatter formatter;
+            article.create_date_ = formatter.format(create_date, "%f %b %Y, %H:%M:%S");
+        }
+        catch (Poco::Data::MySQL::ConnectionException &e)
+        {
+            std::cerr << "Connection to DB error: " << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e)
+        {
+
+            std::cerr << "Statement error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+} // namespace database
@@ -16,6 +16,57 @@ namespace {
     constexpr const char* const  kDefaultDB_Login = "admin";
     constexpr const char* const  kDefaultDB_Password = "admin";
     constexpr const char* const  kDefaultDB_Database = "archdb";
+    constexpr const unsigned int kDefaultDB_PoolMinSessions = 4;
+    constexpr const unsigned int kDefaultDB_PoolMaxSessions = 32;
+    constexpr const unsigned int kDefaultDB_PoolIdleTime = 60;
+    constexpr const unsigned int kDefaultDB_HealthCheckInterval = 10;
+    constexpr const unsigned int kDefaultDB_ConnectRetries = 5;
+    constexpr const unsigned int kDefaultDB_ConnectBackoff = 200;
+    constexpr const unsigned int kDefaultDB_MaxReplicaLag = 5;
+    constexpr const unsigned int kDefaultDB_ReadYourWritesWindow = 2000;
+    constexpr const unsigned int kDefaultDB_ReplicaCheckInterval = 1000;
+    constexpr const char* const  kMySqlStorage = "mysql";
+    constexpr const char* const  kMemoryStorage = "memory";
+    constexpr const char* const  kDefaultDB_Storage = kMySqlStorage;
+
+    constexpr const bool         kDefaultCachingEnabled = true;
+    constexpr const char* const  kDefaultCachingIP = "0.0.0.0";
+    constexpr const unsigned int kDefaultCachingPort = 6379;
+    constexpr const unsigned int kDefaultCachingExpiration = 60;
+    constexpr const unsigned int kDefaultCachingPoolSize = 4;
+    constexpr const unsigned int kDefaultCachingCompressMinSize = 1024;
+    constexpr const char* const  kDefaultCachingBackend = "redis";
+    constexpr const unsigned int kDefaultCachingMemoryMaxEntries = 100000;
+    constexpr const unsigned int kDefaultCachingTimeoutMs = 50;
+    constexpr const unsigned int kDefaultCachingBreakerFailures = 5;
+    constexpr const unsigned int kDefaultCachingBreakerOpenMs = 2000;
+    constexpr const char* const  kDefaultCachingInvalidationChannel = "articles:deleted";
+
+    constexpr const unsigned int kDefaultMinThreads = 2;
+    constexpr const unsigned int kDefaultMaxThreads = 16;
+    constexpr const unsigned int kDefaultMaxQueued = 64;
+    constexpr const unsigned int kDefaultThreadIdleTime = 60;
+    constexpr const bool         kDefaultKeepAlive = true;
+    constexpr const unsigned int kDefaultMaxKeepAliveRequests = 100;
+    constexpr const unsigned int kDefaultKeepAliveTimeout = 10;
+    constexpr const unsigned int kDefaultTimeout = 60;
+    constexpr const unsigned int kDefaultBacklog = 64;
+    constexpr const bool         kDefaultReuseAddress = true;
+    constexpr const bool         kDefaultReusePort = false;
+    constexpr const unsigned int kDefaultMaxQueueWait = 0;
+    constexpr const unsigned int kDefaultMaxPoolWait = 0;
+    constexpr const unsigned int kDefaultRetryAfter = 1;
+    constexpr const char* const  kThreadedMode = "threaded";
+    constexpr const char* const  kEventLoopMode = "event_loop";
+    constexpr const char* const  kDefaultMode = kThreadedMode;
+    constexpr const unsigned int kDefaultReactorThreads = 2;
+    constexpr const bool         kDefaultCompression = true;
+    constexpr const unsigned int kDefaultCompressionMinSize = 1024;
+    constexpr const int          kDefaultCompressionLevel = 6;
+    constexpr const unsigned int kDefaultDownstreamTimeoutMs = 1000;
+    constexpr const unsigned int kDefaultDownstreamBreakerFailures = 5;
+    constexpr const unsigned int kDefaultDownstreamBreakerOpenMs = 2000;
+    constexpr const unsigned int kDefaultRequestTimeoutMs = 0;
 
 } // namespace [ Constants ]
 
@@ -28,7 +79,10 @@ namespace {
             if constexpr ( std::is_constructible_v<ExpectedType, std::string> ) {
                 value = str_representation;
             }
-            if constexpr ( std::is_integral_v<ExpectedType> ) {
+            if constexpr ( std::is_same_v<ExpectedType, bool> ) {
+                value = (str_representation == "true" || str_representation == "1");
+            }
+            if constexpr ( std::is_integral_v<ExpectedType> && !std::is_same_v<ExpectedType, bool> ) {
                 std::istringstream iss(str_representation);
                 if constexpr ( std::is_unsigned_v<ExpectedType> ) {
                     uint64_t integral_value;
@@ -68,6 +122,157 @@ namespace search_service {
     }
 } // namespace search_service
 
+namespace search_service {
+
+    ServerConfig::ServerConfig() noexcept:
+            min_threads_(kDefaultMinThreads),
+            max_threads_(kDefaultMaxThreads),
+            max_queued_(kDefaultMaxQueued),
+            thread_idle_time_(kDefaultThreadIdleTime),
+            keep_alive_(kDefaultKeepAlive),
+            max_keep_alive_requests_(kDefaultMaxKeepAliveRequests),
+            keep_alive_timeout_(kDefaultKeepAliveTimeout),
+            timeout_(kDefaultTimeout),
+            backlog_(kDefaultBacklog),
+            reuse_address_(kDefaultReuseAddress),
+            reuse_port_(kDefaultReusePort),
+            max_queue_wait_(kDefaultMaxQueueWait),
+            max_pool_wait_(kDefaultMaxPoolWait),
+            retry_after_(kDefaultRetryAfter),
+            mode_(kDefaultMode),
+            reactor_threads_(kDefaultReactorThreads),
+            compression_(kDefaultCompression),
+            compression_min_size_(kDefaultCompressionMinSize),
+            compression_level_(kDefaultCompressionLevel),
+            downstream_timeout_ms_(kDefaultDownstreamTimeoutMs),
+            downstream_breaker_failures_(kDefaultDownstreamBreakerFailures),
+            downstream_breaker_open_ms_(kDefaultDownstreamBreakerOpenMs),
+            request_timeout_ms_(kDefaultRequestTimeoutMs) {}
+
+    ServerConfig::ServerConfig(Poco::JSON::Object &json_root) noexcept: ServerConfig() {
+        JsonGetValue(json_root, "min_threads", min_threads_);
+        JsonGetValue(json_root, "max_threads", max_threads_);
+        JsonGetValue(json_root, "max_queued", max_queued_);
+        JsonGetValue(json_root, "thread_idle_time", thread_idle_time_);
+        JsonGetValue(json_root, "keep_alive", keep_alive_);
+        JsonGetValue(json_root, "max_keep_alive_requests", max_keep_alive_requests_);
+        JsonGetValue(json_root, "keep_alive_timeout", keep_alive_timeout_);
+        JsonGetValue(json_root, "timeout", timeout_);
+        JsonGetValue(json_root, "backlog", backlog_);
+        JsonGetValue(json_root, "reuse_address", reuse_address_);
+        JsonGetValue(json_root, "reuse_port", reuse_port_);
+        JsonGetValue(json_root, "max_queue_wait_ms", max_queue_wait_);
+        JsonGetValue(json_root, "max_pool_wait_ms", max_pool_wait_);
+        JsonGetValue(json_root, "retry_after", retry_after_);
+        JsonGetValue(json_root, "mode", mode_);
+        JsonGetValue(json_root, "reactor_threads", reactor_threads_);
+        JsonGetValue(json_root, "compression", compression_);
+        JsonGetValue(json_root, "compression_min_size", compression_min_size_);
+        JsonGetValue(json_root, "compression_level", compression_level_);
+        JsonGetValue(json_root, "downstream_timeout_ms", downstream_timeout_ms_);
+        JsonGetValue(json_root, "downstream_breaker_failures", downstream_breaker_failures_);
+        JsonGetValue(json_root, "downstream_breaker_open_ms", downstream_breaker_open_ms_);
+        JsonGetValue(json_root, "request_timeout_ms", request_timeout_ms_);
+
+        if ( min_threads_ > max_threads_ ) min_threads_ = max_threads_;
+    }
+
+    void ServerConfig::SetMinThreads(unsigned int min_threads) noexcept { min_threads_ = min_threads; }
+
+    void ServerConfig::SetMaxThreads(unsigned int max_threads) noexcept { max_threads_ = max_threads; }
+
+    void ServerConfig::SetMaxQueued(unsigned int max_queued) noexcept { max_queued_ = max_queued; }
+
+    void ServerConfig::SetThreadIdleTime(unsigned int idle_time) noexcept { thread_idle_time_ = idle_time; }
+
+    void ServerConfig::SetKeepAlive(bool keep_alive) noexcept { keep_alive_ = keep_alive; }
+
+    void ServerConfig::SetMaxKeepAliveRequests(unsigned int max_requests) noexcept { max_keep_alive_requests_ = max_requests; }
+
+    void ServerConfig::SetKeepAliveTimeout(unsigned int timeout) noexcept { keep_alive_timeout_ = timeout; }
+
+    void ServerConfig::SetTimeout(unsigned int timeout) noexcept { timeout_ = timeout; }
+
+    void ServerConfig::SetBacklog(unsigned int backlog) noexcept { backlog_ = backlog; }
+
+    void ServerConfig::SetReuseAddress(bool reuse) noexcept { reuse_address_ = reuse; }
+
+    void ServerConfig::SetReusePort(bool reuse) noexcept { reuse_port_ = reuse; }
+
+    void ServerConfig::SetMaxQueueWait(unsigned int wait_ms) noexcept { max_queue_wait_ = wait_ms; }
+
+    void ServerConfig::SetMaxPoolWait(unsigned int wait_ms) noexcept { max_pool_wait_ = wait_ms; }
+
+    void ServerConfig::SetRetryAfter(unsigned int retry_after) noexcept { retry_after_ = retry_after; }
+
+    void ServerConfig::SetMode(const std::string& mode) noexcept { mode_ = mode; }
+
+    void ServerConfig::SetReactorThreads(unsigned int reactor_threads) noexcept { reactor_threads_ = reactor_threads; }
+
+    void ServerConfig::SetCompression(bool compression) noexcept { compression_ = compression; }
+
+    void ServerConfig::SetCompressionMinSize(unsigned int min_size) noexcept { compression_min_size_ = min_size; }
+
+    void ServerConfig::SetCompressionLevel(int level) noexcept { compression_level_ = level; }
+
+    void ServerConfig::SetDownstreamTimeoutMs(unsigned int timeout_ms) noexcept { downstream_timeout_ms_ = timeout_ms; }
+
+    void ServerConfig::SetDownstreamBreakerFailures(unsigned int failures) noexcept { downstream_breaker_failures_ = failures; }
+
+    void ServerConfig::SetDownstreamBreakerOpenMs(unsigned int open_ms) noexcept { downstream_breaker_open_ms_ = open_ms; }
+
+    void ServerConfig::SetRequestTimeoutMs(unsigned int timeout_ms) noexcept { request_timeout_ms_ = timeout_ms; }
+
+    unsigned int ServerConfig::GetMinThreads() const noexcept { return min_threads_; }
+
+    unsigned int ServerConfig::GetMaxThreads() const noexcept { return max_threads_; }
+
+    unsigned int ServerConfig::GetMaxQueued() const noexcept { return max_queued_; }
+
+    unsigned int ServerConfig::GetThreadIdleTime() const noexcept { return thread_idle_time_; }
+
+    bool ServerConfig::GetKeepAlive() const noexcept { return keep_alive_; }
+
+    unsigned int ServerConfig::GetMaxKeepAliveRequests() const noexcept { return max_keep_alive_requests_; }
+
+    unsigned int ServerConfig::GetKeepAliveTimeout() const noexcept { return keep_alive_timeout_; }
+
+    unsigned int ServerConfig::GetTimeout() const noexcept { return timeout_; }
+
+    unsigned int ServerConfig::GetBacklog() const noexcept { return backlog_; }
+
+    bool ServerConfig::GetReuseAddress() const noexcept { return reuse_address_; }
+
+    bool ServerConfig::GetReusePort() const noexcept { return reuse_port_; }
+
+    unsigned int ServerConfig::GetMaxQueueWait() const noexcept { return max_queue_wait_; }
+
+    unsigned int ServerConfig::GetMaxPoolWait() const noexcept { return max_pool_wait_; }
+
+    unsigned int ServerConfig::GetRetryAfter() const noexcept { return retry_after_; }
+
+    std::string ServerConfig::GetMode() const noexcept { return mode_; }
+
+    unsigned int ServerConfig::GetReactorThreads() const noexcept { return reactor_threads_; }
+
+    bool ServerConfig::IsEventLoopMode() const noexcept { return mode_ == kEventLoopMode; }
+
+    bool ServerConfig::GetCompression() const noexcept { return compression_; }
+
+    unsigned int ServerConfig::GetCompressionMinSize() const noexcept { return compression_min_size_; }
+
+    int ServerConfig::GetCompressionLevel() const noexcept { return compression_level_; }
+
+    unsigned int ServerConfig::GetDownstreamTimeoutMs() const noexcept { return downstream_timeout_ms_; }
+
+    unsigned int ServerConfig::GetDownstreamBreakerFailures() const noexcept { return downstream_breaker_failures_; }
+
+    unsigned int ServerConfig::GetDownstreamBreakerOpenMs() const noexcept { return downstream_breaker_open_ms_; }
+
+    unsigned int ServerConfig::GetRequestTimeoutMs() const noexcept { return request_timeout_ms_; }
+
+} // namespace search_service
+
 namespace search_service {
 
     DatabaseConfig::DatabaseConfig() noexcept:
@@ -75,7 +280,17 @@ namespace search_service {
             port_(kDefaultDB_Port),
             login_(kDefaultDB_Login),
             password_(kDefaultDB_Password),
-            database_(kDefaultDB_Database) {}
+            database_(kDefaultDB_Database),
+            pool_min_sessions_(kDefaultDB_PoolMinSessions),
+            pool_max_sessions_(kDefaultDB_PoolMaxSessions),
+            pool_idle_time_(kDefaultDB_PoolIdleTime),
+            health_check_interval_(kDefaultDB_HealthCheckInterval),
+            connect_retries_(kDefaultDB_ConnectRetries),
+            connect_backoff_(kDefaultDB_ConnectBackoff),
+            max_replica_lag_(kDefaultDB_MaxReplicaLag),
+            read_your_writes_window_(kDefaultDB_ReadYourWritesWindow),
+            replica_check_interval_(kDefaultDB_ReplicaCheckInterval),
+            storage_(kDefaultDB_Storage) {}
 
     DatabaseConfig::DatabaseConfig(Poco::JSON::Object &json_root) noexcept: DatabaseConfig() {
         host_ = json_root.getValue<decltype(host_)>("host");
@@ -83,6 +298,30 @@ namespace search_service {
         JsonGetValue(json_root, "login", login_);
         JsonGetValue(json_root, "password", password_);
         JsonGetValue(json_root, "database", database_);
+        JsonGetValue(json_root, "pool_min_sessions", pool_min_sessions_);
+        JsonGetValue(json_root, "pool_max_sessions", pool_max_sessions_);
+        JsonGetValue(json_root, "pool_idle_time", pool_idle_time_);
+        JsonGetValue(json_root, "health_check_interval", health_check_interval_);
+        JsonGetValue(json_root, "connect_retries", connect_retries_);
+        JsonGetValue(json_root, "connect_backoff_ms", connect_backoff_);
+        JsonGetValue(json_root, "max_replica_lag", max_replica_lag_);
+        JsonGetValue(json_root, "read_your_writes_window_ms", read_your_writes_window_);
+        JsonGetValue(json_root, "replica_check_interval_ms", replica_check_interval_);
+        JsonGetValue(json_root, "storage", storage_);
+
+        if ( json_root.has("replicas") ) {
+            Poco::JSON::Array::Ptr replicas = json_root.getArray("replicas");
+            for ( size_t i = 0; i < replicas->size(); i++ ) {
+                Poco::JSON::Object::Ptr replica = replicas->getObject(static_cast<unsigned int>(i));
+                if ( replica.isNull() ) continue;
+
+                ReplicaEndpoint endpoint{ host_, port_, 0 };
+                JsonGetValue(*replica, "host", endpoint.host);
+                JsonGetValue(*replica, "port", endpoint.port);
+                JsonGetValue(*replica, "shard", endpoint.shard_id);
+                replicas_.push_back(std::move(endpoint));
+            }
+        }
     }
 
     void DatabaseConfig::SetHost(const std::string& host) noexcept { host_ = host; }
@@ -95,6 +334,28 @@ namespace search_service {
 
     void DatabaseConfig::SetDatabase(const std::string& database) noexcept { database_ = database; }
 
+    void DatabaseConfig::SetPoolMinSessions(unsigned int min_sessions) noexcept { pool_min_sessions_ = min_sessions; }
+
+    void DatabaseConfig::SetPoolMaxSessions(unsigned int max_sessions) noexcept { pool_max_sessions_ = max_sessions; }
+
+    void DatabaseConfig::SetPoolIdleTime(unsigned int idle_time) noexcept { pool_idle_time_ = idle_time; }
+
+    void DatabaseConfig::SetHealthCheckInterval(unsigned int interval) noexcept { health_check_interval_ = interval; }
+
+    void DatabaseConfig::SetConnectRetries(unsigned int retries) noexcept { connect_retries_ = retries; }
+
+    void DatabaseConfig::SetConnectBackoff(unsigned int backoff_ms) noexcept { connect_backoff_ = backoff_ms; }
+
+    void DatabaseConfig::SetMaxReplicaLag(unsigned int lag_sec) noexcept { max_replica_lag_ = lag_sec; }
+
+    void DatabaseConfig::SetReadYourWritesWindow(unsigned int window_ms) noexcept { read_your_writes_window_ = window_ms; }
+
+    void DatabaseConfig::SetReplicaCheckInterval(unsigned int interval_ms) noexcept { replica_check_interval_ = interval_ms; }
+
+    void DatabaseConfig::SetReplicas(std::vector<ReplicaEndpoint> replicas) noexcept { replicas_ = std::move(replicas); }
+
+    void DatabaseConfig::SetStorage(const std::string& storage) noexcept { storage_ = storage; }
+
     std::string DatabaseConfig::GetHost() const noexcept { return host_; }
 
     unsigned int DatabaseConfig::GetPort() const noexcept { return port_; }
@@ -105,12 +366,119 @@ namespace search_service {
 
     std::string DatabaseConfig::GetDatabase() const noexcept { return database_; }
 
+    unsigned int DatabaseConfig::GetPoolMinSessions() const noexcept { return pool_min_sessions_; }
+
+    unsigned int DatabaseConfig::GetPoolMaxSessions() const noexcept { return pool_max_sessions_; }
+
+    unsigned int DatabaseConfig::GetPoolIdleTime() const noexcept { return pool_idle_time_; }
+
+    unsigned int DatabaseConfig::GetHealthCheckInterval() const noexcept { return health_check_interval_; }
+
+    unsigned int DatabaseConfig::GetConnectRetries() const noexcept { return connect_retries_; }
+
+    unsigned int DatabaseConfig::GetConnectBackoff() const noexcept { return connect_backoff_; }
+
+    unsigned int DatabaseConfig::GetMaxReplicaLag() const noexcept { return max_replica_lag_; }
+
+    unsigned int DatabaseConfig::GetReadYourWritesWindow() const noexcept { return read_your_writes_window_; }
+
+    unsigned int DatabaseConfig::GetReplicaCheckInterval() const noexcept { return replica_check_interval_; }
+
+    const std::vector<ReplicaEndpoint>& DatabaseConfig::GetReplicas() const noexcept { return replicas_; }
+
+    std::string DatabaseConfig::GetStorage() const noexcept { return storage_; }
+
+    bool DatabaseConfig::IsMemoryStorage() const noexcept { return storage_ == kMemoryStorage; }
+
+} // namespace search_service
+
+namespace search_service {
+
+    CachingConfig::CachingConfig() noexcept:
+            enabled_(kDefaultCachingEnabled),
+            host_(kDefaultCachingIP),
+            port_(kDefaultCachingPort),
+            expiration_(kDefaultCachingExpiration),
+            pool_size_(kDefaultCachingPoolSize),
+            compress_min_size_(kDefaultCachingCompressMinSize),
+            backend_(kDefaultCachingBackend),
+            memory_max_entries_(kDefaultCachingMemoryMaxEntries),
+            timeout_ms_(kDefaultCachingTimeoutMs),
+            breaker_failures_(kDefaultCachingBreakerFailures),
+            breaker_open_ms_(kDefaultCachingBreakerOpenMs),
+            invalidation_channel_(kDefaultCachingInvalidationChannel) {}
+
+    CachingConfig::CachingConfig(Poco::JSON::Object &json_root) noexcept : CachingConfig() {
+        JsonGetValue(json_root, "enabled", enabled_);
+        JsonGetValue(json_root, "host", host_);
+        JsonGetValue(json_root, "port", port_);
+        JsonGetValue(json_root, "expiration", expiration_);
+        JsonGetValue(json_root, "pool_size", pool_size_);
+        JsonGetValue(json_root, "compress_min_size", compress_min_size_);
+        JsonGetValue(json_root, "backend", backend_);
+        JsonGetValue(json_root, "memory_max_entries", memory_max_entries_);
+        JsonGetValue(json_root, "timeout_ms", timeout_ms_);
+        JsonGetValue(json_root, "breaker_failures", breaker_failures_);
+        JsonGetValue(json_root, "breaker_open_ms", breaker_open_ms_);
+        JsonGetValue(json_root, "invalidation_channel", invalidation_channel_);
+
+        if ( pool_size_ == 0 ) pool_size_ = 1;
+    }
+
+    void CachingConfig::SetEnabled(bool enabled) noexcept { enabled_ = enabled; }
+
+    void CachingConfig::SetHost(const std::string& host) noexcept { host_ = host; }
+
+    void CachingConfig::SetPort(unsigned int port) noexcept { port_ = port; }
+
+    void CachingConfig::SetExpiration(unsigned int expiration) noexcept { expiration_ = expiration; }
+
+    void CachingConfig::SetPoolSize(unsigned int pool_size) noexcept { pool_size_ = pool_size; }
+
+    void CachingConfig::SetCompressMinSize(unsigned int min_size) noexcept { compress_min_size_ = min_size; }
+
+    void CachingConfig::SetBackend(const std::string& backend) noexcept { backend_ = backend; }
+
+    void CachingConfig::SetMemoryMaxEntries(unsigned int max_entries) noexcept { memory_max_entries_ = max_entries; }
+
+    void CachingConfig::SetTimeoutMs(unsigned int timeout_ms) noexcept { timeout_ms_ = timeout_ms; }
+
+    void CachingConfig::SetBreakerFailures(unsigned int failures) noexcept { breaker_failures_ = failures; }
+
+    void CachingConfig::SetBreakerOpenMs(unsigned int open_ms) noexcept { breaker_open_ms_ = open_ms; }
+
+    void CachingConfig::SetInvalidationChannel(const std::string& channel) noexcept { invalidation_channel_ = channel; }
+
+    bool CachingConfig::GetEnabled() const noexcept { return enabled_; }
+
+    std::string CachingConfig::GetHost() const noexcept { return host_; }
+
+    unsigned int CachingConfig::GetPort() const noexcept { return port_; }
+
+    unsigned int CachingConfig::GetExpiration() const noexcept { return expiration_; }
+
+    unsigned int CachingConfig::GetPoolSize() const noexcept { return pool_size_; }
+
+    unsigned int CachingConfig::GetCompressMinSize() const noexcept { return compress_min_size_; }
+
+    std::string CachingConfig::GetBackend() const noexcept { return backend_; }
+
+    unsigned int CachingConfig::GetMemoryMaxEntries() const noexcept { return memory_max_entries_; }
+
+    unsigned int CachingConfig::GetTimeoutMs() const noexcept { return timeout_ms_; }
+
+    unsigned int CachingConfig::GetBreakerFailures() const noexcept { return breaker_failures_; }
+
+    unsigned int CachingConfig::GetBreakerOpenMs() const noexcept { return breaker_open_ms_; }
+
+    std::string CachingConfig::GetInvalidationChannel() const noexcept { return invalidation_channel_; }
+
 } // namespace search_service
 
 namespace search_service {
 
     Config::Config(const std::string &path) :
-        network_config_(nullptr), database_config_(nullptr) {
+        network_config_(nullptr), server_config_(nullptr), database_config_(nullptr) {
 
         config::utils::ValidateJsonPath(path);
 
@@ -130,15 +498,29 @@ namespace search_service {
         } else {
             network_config_ = std::make_shared<NetworkConfig>();
         }
+        if ( root->has("server") ) {
+            server_config_ = std::make_shared<ServerConfig>(*root->getObject("server"));
+        } else {
+            server_config_ = std::make_shared<ServerConfig>();
+        }
         if ( root->has("database") ) {
             database_config_ = std::make_shared<DatabaseConfig>(*root->getObject("database"));
         } else {
             database_config_ = std::make_shared<DatabaseConfig>();
         }
+        if ( root->has("caching") ) {
+            caching_config_ = std::make_shared<CachingConfig>(*root->getObject("caching"));
+        } else {
+            caching_config_ = std::make_shared<CachingConfig>();
+        }
     }
 
     std::shared_ptr<NetworkConfig> Config::GetNetworkConfig() const noexcept { return network_config_; }
 
+    std::shared_ptr<ServerConfig> Config::GetServerConfig() const noexcept { return server_config_; }
+
     std::shared_ptr<DatabaseConfig> Config::GetDatabaseConfig() const noexcept { return database_config_; }
 
+    std::shared_ptr<CachingConfig> Config::GetCachingConfig() const noexcept { return caching_config_; }
+
 } // namespace search_service
\ No newline at end of file
@@ -3,6 +3,9 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+
+#include "../../../shared/replica_router.h"
 
 namespace Poco::JSON {
     class Object;
@@ -29,6 +32,86 @@ namespace search_service {
         unsigned int port_;
     };
 
+    class ServerConfig {
+    public:
+        ServerConfig() noexcept;
+        explicit ServerConfig(Poco::JSON::Object& json_root) noexcept;
+
+        void SetMinThreads(unsigned int) noexcept;
+        void SetMaxThreads(unsigned int) noexcept;
+        void SetMaxQueued(unsigned int) noexcept;
+        void SetThreadIdleTime(unsigned int) noexcept;
+        void SetKeepAlive(bool) noexcept;
+        void SetMaxKeepAliveRequests(unsigned int) noexcept;
+        void SetKeepAliveTimeout(unsigned int) noexcept;
+        void SetTimeout(unsigned int) noexcept;
+        void SetBacklog(unsigned int) noexcept;
+        void SetReuseAddress(bool) noexcept;
+        void SetReusePort(bool) noexcept;
+        void SetMaxQueueWait(unsigned int) noexcept;
+        void SetMaxPoolWait(unsigned int) noexcept;
+        void SetRetryAfter(unsigned int) noexcept;
+        void SetMode(const std::string&) noexcept;
+        void SetReactorThreads(unsigned int) noexcept;
+        void SetCompression(bool) noexcept;
+        void SetCompressionMinSize(unsigned int) noexcept;
+        void SetCompressionLevel(int) noexcept;
+        void SetDownstreamTimeoutMs(unsigned int) noexcept;
+        void SetDownstreamBreakerFailures(unsigned int) noexcept;
+        void SetDownstreamBreakerOpenMs(unsigned int) noexcept;
+        void SetRequestTimeoutMs(unsigned int) noexcept;
+
+        unsigned int GetMinThreads() const noexcept;
+        unsigned int GetMaxThreads() const noexcept;
+        unsigned int GetMaxQueued() const noexcept;
+        unsigned int GetThreadIdleTime() const noexcept;
+        bool GetKeepAlive() const noexcept;
+        unsigned int GetMaxKeepAliveRequests() const noexcept;
+        unsigned int GetKeepAliveTimeout() const noexcept;
+        unsigned int GetTimeout() const noexcept;
+        unsigned int GetBacklog() const noexcept;
+        bool GetReuseAddress() const noexcept;
+        bool GetReusePort() const noexcept;
+        unsigned int GetMaxQueueWait() const noexcept;
+        unsigned int GetMaxPoolWait() const noexcept;
+        unsigned int GetRetryAfter() const noexcept;
+        std::string GetMode() const noexcept;
+        unsigned int GetReactorThreads() const noexcept;
+        bool IsEventLoopMode() const noexcept;
+        bool GetCompression() const noexcept;
+        unsigned int GetCompressionMinSize() const noexcept;
+        int GetCompressionLevel() const noexcept;
+        unsigned int GetDownstreamTimeoutMs() const noexcept;
+        unsigned int GetDownstreamBreakerFailures() const noexcept;
+        unsigned int GetDownstreamBreakerOpenMs() const noexcept;
+        unsigned int GetRequestTimeoutMs() const noexcept;
+
+    private:
+        unsigned int min_threads_;
+        unsigned int max_threads_;
+        unsigned int max_queued_;
+        unsigned int thread_idle_time_;
+        bool keep_alive_;
+        unsigned int max_keep_alive_requests_;
+        unsigned int keep_alive_timeout_;
+        unsigned int timeout_;
+        unsigned int backlog_;
+        bool reuse_address_;
+        bool reuse_port_;
+        unsigned int max_queue_wait_;
+        unsigned int max_pool_wait_;
+        unsigned int retry_after_;
+        std::string mode_;
+        unsigned int reactor_threads_;
+        bool compression_;
+        unsigned int compression_min_size_;
+        int compression_level_;
+        unsigned int downstream_timeout_ms_;
+        unsigned int downstream_breaker_failures_;
+        unsigned int downstream_breaker_open_ms_;
+        unsigned int request_timeout_ms_;
+    };
+
     class DatabaseConfig {
     public:
         DatabaseConfig() noexcept;
@@ -39,12 +122,37 @@ namespace search_service {
         void SetLogin(const std::string&) noexcept;
         void SetPassword(const std::string&) noexcept;
         void SetDatabase(const std::string&) noexcept;
+        void SetPoolMinSessions(unsigned int) noexcept;
+        void SetPoolMaxSessions(unsigned int) noexcept;
+        void SetPoolIdleTime(unsigned int) noexcept;
+        void SetHealthCheckInterval(unsigned int) noexcept;
+        void SetConnectRetries(unsigned int) noexcept;
+        void SetConnectBackoff(unsigned int) noexcept;
+        void SetMaxReplicaLag(unsigned int) noexcept;
+        void SetReadYourWritesWindow(unsigned int) noexcept;
+        void SetReplicaCheckInterval(unsigned int) noexcept;
+        void SetReplicas(std::vector<ReplicaEndpoint>) noexcept;
+        void SetStorage(const std::string&) noexcept;
 
         std::string GetHost() const noexcept;
         unsigned int GetPort() const noexcept;
         std::string GetLogin() const noexcept;
         std::string GetPassword() const noexcept;
         std::string GetDatabase() const noexcept;
+        unsigned int GetPoolMinSessions() const noexcept;
+        unsigned int GetPoolMaxSessions() const noexcept;
+        unsigned int GetPoolIdleTime() const noexcept;
+        unsigned int GetHealthCheckInterval() const noexcept;
+        unsigned int GetConnectRetries() const noexcept;
+        unsigned int GetConnectBackoff() const noexcept;
+        unsigned int GetMaxReplicaLag() const noexcept;
+        unsigned int GetReadYourWritesWindow() const noexcept;
+        unsigned int GetReplicaCheckInterval() const noexcept;
+        const std::vector<ReplicaEndpoint>& GetReplicas() const noexcept;
+        std::string GetStorage() const noexcept;
+
+        /* Статьи хранятся в памяти процесса, подключение к БД не требуется */
+        bool IsMemoryStorage() const noexcept;
 
     private:
         std::string host_;
@@ -52,6 +160,63 @@ namespace search_service {
         std::string login_;
         std::string password_;
         std::string database_;
+        unsigned int pool_min_sessions_;
+        unsigned int pool_max_sessions_;
+        unsigned int pool_idle_time_;
+        unsigned int health_check_interval_;
+        unsigned int connect_retries_;
+        unsigned int connect_backoff_;
+        unsigned int max_replica_lag_;
+        unsigned int read_your_writes_window_;
+        unsigned int replica_check_interval_;
+        std::vector<ReplicaEndpoint> replicas_;
+        std::string storage_;
+    };
+
+    class CachingConfig {
+    public:
+        CachingConfig() noexcept;
+        explicit CachingConfig(Poco::JSON::Object& json_root) noexcept;
+
+        void SetEnabled(bool) noexcept;
+        void SetHost(const std::string&) noexcept;
+        void SetPort(unsigned int) noexcept;
+        void SetExpiration(unsigned int) noexcept;
+        void SetPoolSize(unsigned int) noexcept;
+        void SetCompressMinSize(unsigned int) noexcept;
+        void SetBackend(const std::string&) noexcept;
+        void SetMemoryMaxEntries(unsigned int) noexcept;
+        void SetTimeoutMs(unsigned int) noexcept;
+        void SetBreakerFailures(unsigned int) noexcept;
+        void SetBreakerOpenMs(unsigned int) noexcept;
+        void SetInvalidationChannel(const std::string&) noexcept;
+
+        bool GetEnabled() const noexcept;
+        std::string GetHost() const noexcept;
+        unsigned int GetPort() const noexcept;
+        unsigned int GetExpiration() const noexcept;
+        unsigned int GetPoolSize() const noexcept;
+        unsigned int GetCompressMinSize() const noexcept;
+        std::string GetBackend() const noexcept;
+        unsigned int GetMemoryMaxEntries() const noexcept;
+        unsigned int GetTimeoutMs() const noexcept;
+        unsigned int GetBreakerFailures() const noexcept;
+        unsigned int GetBreakerOpenMs() const noexcept;
+        std::string GetInvalidationChannel() const noexcept;
+
+    private:
+        bool enabled_;
+        std::string host_;
+        unsigned int port_;
+        unsigned int expiration_;
+        unsigned int pool_size_;
+        unsigned int compress_min_size_;
+        std::string backend_;
+        unsigned int memory_max_entries_;
+        unsigned int timeout_ms_;
+        unsigned int breaker_failures_;
+        unsigned int breaker_open_ms_;
+        std::string invalidation_channel_;
     };
 
     class Config {
@@ -68,11 +233,17 @@ namespace search_service {
 
         [[nodiscard]] std::shared_ptr<NetworkConfig> GetNetworkConfig() const noexcept;
 
+        [[nodiscard]] std::shared_ptr<ServerConfig> GetServerConfig() const noexcept;
+
         [[nodiscard]] std::shared_ptr<DatabaseConfig> GetDatabaseConfig() const noexcept;
 
+        [[nodiscard]] std::shared_ptr<CachingConfig> GetCachingConfig() const noexcept;
+
     private:
         std::shared_ptr<NetworkConfig> network_config_;
+        std::shared_ptr<ServerConfig> server_config_;
         std::shared_ptr<DatabaseConfig> database_config_;
+        std::shared_ptr<CachingConfig> caching_config_;
     };
 
 } // namespace search_service
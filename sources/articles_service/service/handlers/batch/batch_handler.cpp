@@ -0,0 +1,145 @@
+#include "batch_handler.h"
+
+#include <Poco/JSON/Object.h>
+#include <Poco/Net/HTMLForm.h>
+#include <Poco/NumberParser.h>
+#include <Poco/StringTokenizer.h>
+
+#include "database/user_role.h"
+#include "database/article.h"
+
+#include "../../../../shared/errors.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using Poco::Net::HTMLForm;
+
+namespace {
+
+    /* Ограничение длины IN (...) в одном запросе */
+    constexpr const size_t kMaxBatchSize = 100;
+
+    /* Поля по умолчанию - то, что нужно спискам статей, без description и content */
+    const char* const kDefaultFields[] = { "id", "consumer_id", "title" };
+
+} // namespace [ Constants ]
+
+namespace handler {
+
+    BatchHandler::BatchHandler(const std::string &format) :
+        IRequestHandler(format, HandlerType::Batch, "/articles") { /* Empty */ }
+
+    void BatchHandler::handleRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
+        try {
+            if ( request.getMethod() == HTTPServerRequest::HTTP_GET ) {
+                HandleGetRequest(request, response);
+            } else {
+                SetBadRequestResponse(response, "Service unsupported this method for /articles URI.");
+            }
+
+        } catch (const exceptions::DeadlineExceeded& e) {
+
+            SetGatewayTimeoutResponse(response, e.what());
+
+        } catch (const std::exception& e) {
+
+            std::string error_desc{ "Server end of work with exception: " };
+            error_desc += e.what();
+            SetInternalErrorResponse(response, error_desc);
+
+        }
+    }
+
+    void BatchHandler::HandleGetRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
+
+        database::UserRole user_role;
+        if ( request.hasCredentials() ) {
+
+            auto user_data = AuthRequest(request, response);
+            if ( !user_data.has_value() )
+                return;
+            user_role = database::UserRole(user_data.value().first);
+        } else {
+            SetUnauthorizedResponse(response, "User is unauthorized.");
+            return;
+        }
+
+        if ( user_role < database::UserRole::User ) {
+            SetPermissionDeniedResponse(response, "You don't have permission for this action.");
+            return;
+        }
+
+        HTMLForm form(request);
+
+        if ( !form.has("ids") ) {
+            SetBadRequestResponse(response, "Need ids in request data.");
+            return;
+        }
+
+        std::vector<long> ids;
+        std::unordered_set<long> unique_ids;
+        Poco::StringTokenizer tokens(form.get("ids"), ",",
+                                     Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+        for ( const auto& token : tokens ) {
+            Poco::Int64 id;
+            if ( !Poco::NumberParser::tryParse64(token, id) ) {
+                SetBadRequestResponse(response, "Wrong article id: " + token);
+                return;
+            }
+            if ( unique_ids.insert(static_cast<long>(id)).second ) {
+                ids.push_back(static_cast<long>(id));
+            }
+        }
+
+        if ( ids.size() > kMaxBatchSize ) {
+            SetBadRequestResponse(response, "Too many ids, maximum is " + std::to_string(kMaxBatchSize) + ".");
+            return;
+        }
+
+        std::vector<std::string> fields(std::begin(kDefaultFields), std::end(kDefaultFields));
+        if ( form.has("fields") ) {
+            fields.clear();
+            Poco::StringTokenizer names(form.get("fields"), ",",
+                                        Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+            for ( const auto& name : names ) {
+                if ( !database::Article::IsProjectableField(name) ) {
+                    SetBadRequestResponse(response, "Unknown article field: " + name);
+                    return;
+                }
+                if ( std::find(fields.begin(), fields.end(), name) == fields.end() ) {
+                    fields.push_back(name);
+                }
+            }
+        }
+
+        std::unordered_map<long, database::Article> found;
+        for ( auto& article : database::Article::SearchByIDs(ids, fields) ) {
+            long id = article.GetID();
+            found.emplace(id, std::move(article));
+        }
+
+        Poco::JSON::Array arr;
+        for ( long id : ids ) {
+            auto it = found.find(id);
+            if ( it == found.end() ) continue;
+            arr.add(it->second.ToJSON(fields));
+        }
+
+        response.setStatus(Poco::Net::HTTPResponse::HTTPStatus::HTTP_OK);
+        response.setContentType("application/json");
+        Poco::JSON::Object::Ptr root = new Poco::JSON::Object();
+        root->set("type", "/success");
+        root->set("title", "OK");
+        root->set("status", Poco::Net::HTTPResponse::HTTP_REASON_OK);
+        root->set("instance", "/articles");
+        root->set("articles", arr);
+
+        SendJSON(request, response, root);
+    }
+
+} // namespace handler
@@ -0,0 +1,30 @@
+#ifndef SERVER_BATCH_HANDLER_H
+#define SERVER_BATCH_HANDLER_H
+
+#include "../interface/i_request_handler.h"
+
+namespace handler {
+
+    /**
+     * @brief Пакетное получение статей: GET /articles?ids=1,2,3&fields=title,consumer_id.
+     * @details Все статьи читаются одним запросом к БД, из которого выбираются только
+     * колонки из fields (по умолчанию id, consumer_id, title). Статьи возвращаются в порядке
+     * запрошенных id, отсутствующие id пропускаются.
+     */
+    class BatchHandler : public IRequestHandler {
+    public:
+        explicit BatchHandler(const std::string& format);
+        ~BatchHandler() override = default;
+
+    public:
+        void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response) override;
+
+    private:
+
+        void HandleGetRequest(HTTPServerRequest& request, HTTPServerResponse& response);
+
+    };
+
+} // namespace handler
+
+#endif //SERVER_BATCH_HANDLER_H
@@ -0,0 +1,70 @@
+#include "exists_handler.h"
+
+#include <Poco/JSON/Object.h>
+#include <Poco/Net/HTMLForm.h>
+
+#include "database/article.h"
+
+#include "../../../../shared/errors.h"
+
+#include <string>
+
+using Poco::Net::HTMLForm;
+
+namespace handler {
+
+    ExistsHandler::ExistsHandler(const std::string &format) :
+        IRequestHandler(format, HandlerType::Exists, "/exists") { /* Empty */ }
+
+    void ExistsHandler::handleRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
+        try {
+            if ( request.getMethod() == HTTPServerRequest::HTTP_GET ||
+                 request.getMethod() == HTTPServerRequest::HTTP_HEAD ) {
+                HandleGetRequest(request, response);
+            } else {
+                SetBadRequestResponse(response, "Service unsupported this method for /exists URI.");
+            }
+
+        } catch (const exceptions::DeadlineExceeded& e) {
+
+            SetGatewayTimeoutResponse(response, e.what());
+
+        } catch (const std::exception& e) {
+
+            std::string error_desc{ "Server end of work with exception: " };
+            error_desc += e.what();
+            SetInternalErrorResponse(response, error_desc);
+
+        }
+    }
+
+    void ExistsHandler::HandleGetRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
+
+        HTMLForm form(request);
+
+        if ( !form.has("id") ) {
+            SetBadRequestResponse(response, "Need ID in request data.");
+            return;
+        }
+
+        long id = atol(form.get("id").c_str());
+        bool exists = database::Article::Exists(id);
+
+        response.setStatus(exists ? Poco::Net::HTTPResponse::HTTPStatus::HTTP_OK
+                                  : Poco::Net::HTTPResponse::HTTPStatus::HTTP_NOT_FOUND);
+        response.setContentType("application/json");
+
+        if ( request.getMethod() == HTTPServerRequest::HTTP_HEAD ) {
+            response.setContentLength(0);
+            response.send();
+            return;
+        }
+
+        Poco::JSON::Object::Ptr root = new Poco::JSON::Object();
+        root->set("instance", "/exists");
+        root->set("id", id);
+        root->set("exists", exists);
+        SendJSON(request, response, root);
+    }
+
+} // namespace handler
@@ -0,0 +1,29 @@
+#ifndef SERVER_EXISTS_HANDLER_H
+#define SERVER_EXISTS_HANDLER_H
+
+#include "../interface/i_request_handler.h"
+
+namespace handler {
+
+    /**
+     * @brief Проверка существования статьи без чтения строки из БД.
+     * @details GET и HEAD /exists?id=. 200 - статья есть, 404 - нет.
+     * Используется другими сервисами, поэтому не требует авторизации и не отдает содержимое статьи.
+     */
+    class ExistsHandler : public IRequestHandler {
+    public:
+        explicit ExistsHandler(const std::string& format);
+        ~ExistsHandler() override = default;
+
+    public:
+        void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response) override;
+
+    private:
+
+        void HandleGetRequest(HTTPServerRequest& request, HTTPServerResponse& response);
+
+    };
+
+} // namespace handler
+
+#endif //SERVER_EXISTS_HANDLER_H
@@ -2,6 +2,8 @@
 
 #include "../article/article_handler.h"
 #include "../search/search_handler.h"
+#include "../exists/exists_handler.h"
+#include "../batch/batch_handler.h"
 
 #include "../../../../shared/errors.h"
 
@@ -13,9 +15,17 @@ namespace {
     std::optional<handler::HandlerType> GetTypeByURI( const std::string& URI ) {
         static const std::map<std::string, handler::HandlerType> handlers_uri_map = {
                 { "/article", handler::HandlerType::Article },
-                { "/search",  handler::HandlerType::Search }
+                { "/search",  handler::HandlerType::Search },
+                { "/exists",  handler::HandlerType::Exists },
+                { "/articles", handler::HandlerType::Batch }
         };
 
+        /* Точное совпадение пути, иначе /article перехватил бы /articles */
+        auto exact = handlers_uri_map.find(URI.substr(0, URI.find('?')));
+        if ( exact != handlers_uri_map.end() ) {
+            return exact->second;
+        }
+
         for ( const auto& [ handler_uri, handler_type ] : handlers_uri_map ) {
             if ( URI.find(handler_uri) != std::string::npos ) {
                 return handler_type;
@@ -41,6 +51,10 @@ namespace handler {
                 return new ArticleHandler(format);
             case HandlerType::Search:
                 return new SearchHandler(format);
+            case HandlerType::Exists:
+                return new ExistsHandler(format);
+            case HandlerType::Batch:
+                return new BatchHandler(format);
         }
 
         throw exceptions::UnexpectedHandlerType("Unknown handler type " + std::to_string(static_cast<int>(type.value())));
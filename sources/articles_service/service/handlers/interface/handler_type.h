@@ -9,7 +9,9 @@ namespace handler {
     public:
         enum Type : uint8_t {
             Article,
-            Search
+            Search,
+            Exists,
+            Batch
         };
 
         HandlerType() = default;
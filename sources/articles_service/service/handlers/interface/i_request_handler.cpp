@@ -4,7 +4,15 @@
 #include <Poco/Net/HTTPClientSession.h>
 #include <Poco/URI.h>
 #include <Poco/JSON/Parser.h>
+#include <Poco/Timestamp.h>
 
+#include "../../../../shared/etag.h"
+#include "../../../../shared/response_compression.h"
+#include "../../../../shared/circuit_breaker.h"
+#include "../../../../shared/request_deadline.h"
+
+#include <algorithm>
+#include <sstream>
 #include <utility>
 
 namespace {
@@ -13,6 +21,37 @@ namespace {
 
 } // namespace constants
 
+namespace {
+
+    /* Таймаут соединения и чтения ответа - таймаут предохранителя, но не дольше остатка срока запроса */
+    void SetDownstreamTimeout(Poco::Net::HTTPClientSession& session, const search_service::CircuitBreaker& breaker) {
+        unsigned int timeout_ms = breaker.GetTimeout();
+        if ( auto remaining = search_service::RequestDeadline::Remaining() ) {
+            unsigned int budget_ms = std::max(1u, *remaining);
+            timeout_ms = timeout_ms == 0 ? budget_ms : std::min(timeout_ms, budget_ms);
+        }
+        if ( timeout_ms > 0 ) {
+            auto timeout = static_cast<Poco::Timespan::TimeDiff>(timeout_ms) * Poco::Timespan::MILLISECONDS;
+            session.setTimeout(Poco::Timespan(timeout));
+        }
+    }
+
+    /* Ответ 5xx считается отказом зависимости, остальные - успешным вызовом.
+     * 504 после истечения нашего срока - отказ вызывающего, а не зависимости. */
+    void RecordDownstreamResult(search_service::CircuitBreaker& breaker, const Poco::Net::HTTPResponse& downstream_response,
+                                const Poco::Timestamp& start) {
+        if ( downstream_response.getStatus() == Poco::Net::HTTPResponse::HTTPStatus::HTTP_GATEWAY_TIMEOUT &&
+             search_service::RequestDeadline::Expired() ) {
+            breaker.RecordAbandoned();
+        } else if ( downstream_response.getStatus() >= Poco::Net::HTTPResponse::HTTPStatus::HTTP_INTERNAL_SERVER_ERROR ) {
+            breaker.RecordFailure();
+        } else {
+            breaker.RecordSuccess(static_cast<double>(start.elapsed()) / 1000.0);
+        }
+    }
+
+} // namespace [ Functions ]
+
 namespace handler {
 
     IRequestHandler::IRequestHandler(std::string format, HandlerType type, std::string instance_name) :
@@ -32,6 +71,30 @@ namespace handler {
         return type_;
     }
 
+    /**
+     * @brief Заполнение NotModified(304) ответа на условный GET.
+     * @param etag - ETag текущего представления ресурса.
+     * @return true, если ответ 304 отправлен и тело передавать не нужно.
+     */
+    bool IRequestHandler::SetNotModifiedResponse(HTTPServerRequest &request, HTTPServerResponse &response,
+                                                 const std::string &etag) {
+        response.set("ETag", etag);
+        response.set("Cache-Control", "private, no-cache");
+
+        if ( !request.has("If-None-Match") ) return false;
+
+        std::optional<std::string> matched = search_service::MatchIfNoneMatch(request.get("If-None-Match"), etag);
+        if ( !matched.has_value() ) return false;
+
+        /* 304 подтверждает представление клиента вместе с его кодировкой */
+        response.set("ETag", *matched);
+        response.setStatus(Poco::Net::HTTPResponse::HTTPStatus::HTTP_NOT_MODIFIED);
+        response.setChunkedTransferEncoding(false);
+        response.setContentLength(0);
+        response.send();
+        return true;
+    }
+
     /**
      * @brief Заполнение BadRequest(400) формы ответа
      * @param response HTML ответ для записи.
@@ -154,6 +217,58 @@ namespace handler {
         Poco::JSON::Stringifier::stringify(root, ostr);
     }
 
+    /**
+     * @brief Заполнение ServiceUnavailable(503) формы ответа
+     * @param response HTML ответ для записи.
+     * @param description - описание ошибки.
+     * @param retry_after - значение заголовка Retry-After в секундах.
+     */
+    void IRequestHandler::SetServiceUnavailableResponse(Poco::Net::HTTPServerResponse &response,
+                                                        const std::string &description, unsigned int retry_after) {
+        response.setStatus(Poco::Net::HTTPResponse::HTTPStatus::HTTP_SERVICE_UNAVAILABLE);
+        response.set("Retry-After", std::to_string(std::max(1u, retry_after)));
+        response.setChunkedTransferEncoding(true);
+        response.setContentType("application/json");
+        Poco::JSON::Object::Ptr root = new Poco::JSON::Object();
+        root->set("type", "/errors/service_unavailable");
+        root->set("title", "Service unavailable.");
+        root->set("status", Poco::Net::HTTPResponse::HTTP_REASON_SERVICE_UNAVAILABLE);
+        root->set("detail", description);
+        root->set("instance", this->Instance());
+        std::ostream &ostr = response.send();
+        Poco::JSON::Stringifier::stringify(root, ostr);
+    }
+
+    /**
+     * @brief Заполнение GatewayTimeout(504) формы ответа
+     * @param response HTML ответ для записи.
+     * @param description - описание ошибки.
+     */
+    void IRequestHandler::SetGatewayTimeoutResponse(Poco::Net::HTTPServerResponse &response,
+                                                    const std::string &description) {
+        response.setStatus(Poco::Net::HTTPResponse::HTTPStatus::HTTP_GATEWAY_TIMEOUT);
+        response.setChunkedTransferEncoding(true);
+        response.setContentType("application/json");
+        Poco::JSON::Object::Ptr root = new Poco::JSON::Object();
+        root->set("type", "/errors/gateway_timeout");
+        root->set("title", "Gateway timeout.");
+        root->set("status", Poco::Net::HTTPResponse::HTTP_REASON_GATEWAY_TIMEOUT);
+        root->set("detail", description);
+        root->set("instance", this->Instance());
+        std::ostream &ostr = response.send();
+        Poco::JSON::Stringifier::stringify(root, ostr);
+    }
+
+    /**
+     * @brief Отправка JSON тела ответа.
+     * @details Большие ответы сжимаются, если клиент прислал подходящий Accept-Encoding.
+     */
+    void IRequestHandler::SendJSON(HTTPServerRequest &request, HTTPServerResponse &response, const Poco::Dynamic::Var &json) {
+        std::ostringstream body;
+        Poco::JSON::Stringifier::stringify(json, body);
+        search_service::ResponseCompression::Instance().Send(request, response, body.str());
+    }
+
     std::optional<std::pair<std::string, long>>
     IRequestHandler::AuthRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
 
@@ -170,23 +285,50 @@ namespace handler {
         std::string url = kAuthServer;
         std::cout << auth_token << std::endl;
 
-        Poco::URI uri(url);
-        Poco::Net::HTTPClientSession s(uri.getHost(), uri.getPort());
-        Poco::Net::HTTPRequest auth_request(Poco::Net::HTTPRequest::HTTP_GET, uri.toString());
-        auth_request.setVersion(Poco::Net::HTTPMessage::HTTP_1_1);
-        auth_request.setContentType("application/json");
-        auth_request.setCredentials(schema, base64);
-        auth_request.setProxyCredentials(schema, base64);
-        auth_request.set("Accept", "application/json");
-        auth_request.setKeepAlive(true);
+        if ( search_service::RequestDeadline::Expired() ) {
+            SetGatewayTimeoutResponse(response, "Request deadline exceeded before calling users service.");
+            return { };
+        }
 
-        s.sendRequest(auth_request);
+        auto& breaker = search_service::CircuitBreaker::Get(search_service::kUsersServiceBreaker);
+        if ( !breaker.Allow() ) {
+            SetServiceUnavailableResponse(response, "Users service is unavailable.", breaker.RetryAfter());
+            return { };
+        }
 
+        Poco::URI uri(url);
         Poco::Net::HTTPResponse auth_response;
-        std::istream &rs = s.receiveResponse(auth_response);
-
-        Poco::JSON::Parser parser;
-        auto json_response = parser.parse(rs).extract<Poco::JSON::Object::Ptr>();
+        Poco::JSON::Object::Ptr json_response;
+        Poco::Timestamp start;
+        try {
+            Poco::Net::HTTPClientSession s(uri.getHost(), uri.getPort());
+            SetDownstreamTimeout(s, breaker);
+            Poco::Net::HTTPRequest auth_request(Poco::Net::HTTPRequest::HTTP_GET, uri.toString());
+            auth_request.setVersion(Poco::Net::HTTPMessage::HTTP_1_1);
+            auth_request.setContentType("application/json");
+            auth_request.setCredentials(schema, base64);
+            auth_request.setProxyCredentials(schema, base64);
+            auth_request.set("Accept", "application/json");
+            auth_request.setKeepAlive(true);
+            search_service::RequestDeadline::Propagate(auth_request);
+
+            s.sendRequest(auth_request);
+
+            std::istream &rs = s.receiveResponse(auth_response);
+
+            Poco::JSON::Parser parser;
+            json_response = parser.parse(rs).extract<Poco::JSON::Object::Ptr>();
+        } catch ( const Poco::Exception& e ) {
+            if ( search_service::RequestDeadline::Expired() ) {
+                breaker.RecordAbandoned();
+                SetGatewayTimeoutResponse(response, "Request deadline exceeded waiting for users service: " + e.displayText());
+                return { };
+            }
+            breaker.RecordFailure();
+            SetServiceUnavailableResponse(response, "Users service is unavailable: " + e.displayText(), breaker.RetryAfter());
+            return { };
+        }
+        RecordDownstreamResult(breaker, auth_response, start);
 
         if ( auth_response.getStatus() != Poco::Net::HTTPResponse::HTTPStatus::HTTP_OK ) {
             response.setStatus(auth_response.getStatus());
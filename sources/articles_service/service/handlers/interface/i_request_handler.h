@@ -6,6 +6,7 @@
 #include "Poco/Net/HTTPRequestHandler.h"
 #include "Poco/Net/HTTPServerRequest.h"
 #include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Dynamic/Var.h"
 
 #include <optional>
 
@@ -31,6 +32,9 @@ namespace handler {
 
         std::string& GetFormat() noexcept;
 
+        /* 304. Выставляет ETag и отвечает 304, если If-None-Match запроса совпал с ним. */
+        bool SetNotModifiedResponse(HTTPServerRequest& request, HTTPServerResponse& response, const std::string& etag);
+
         /* 400 */
         void SetBadRequestResponse(HTTPServerResponse& response, const std::string& description);
 
@@ -49,6 +53,16 @@ namespace handler {
         /* 500 */
         void SetInternalErrorResponse(HTTPServerResponse& response, const std::string& description);
 
+        /* 503. Зависимость недоступна, повтор не раньше retry_after секунд. */
+        void SetServiceUnavailableResponse(HTTPServerResponse& response, const std::string& description,
+                                           unsigned int retry_after);
+
+        /* 504. Срок запроса истёк до получения ответа. */
+        void SetGatewayTimeoutResponse(HTTPServerResponse& response, const std::string& description);
+
+        /* Отправка JSON тела ответа со сжатием по Accept-Encoding */
+        void SendJSON(HTTPServerRequest& request, HTTPServerResponse& response, const Poco::Dynamic::Var& json);
+
         std::optional<std::pair<std::string, long>>
         AuthRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response);
 
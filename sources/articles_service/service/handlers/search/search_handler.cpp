@@ -12,6 +12,8 @@
 #include "database/user_role.h"
 #include "database/article.h"
 
+#include "../../../../shared/errors.h"
+
 #include <iostream>
 #include <string>
 #include <vector>
@@ -31,6 +33,10 @@ namespace handler {
                 SetBadRequestResponse(response, "Service unsupported this method for /search URI.");
             }
 
+        } catch (const exceptions::DeadlineExceeded& e) {
+
+            SetGatewayTimeoutResponse(response, e.what());
+
         } catch (const std::exception& e) {
 
             std::string error_desc{ "Server end of work with exception: " };
@@ -80,8 +86,7 @@ namespace handler {
         }
         root->set("articles", arr);
 
-        std::ostream &ostr = response.send();
-        Poco::JSON::Stringifier::stringify(root, ostr);
+        SendJSON(request, response, root);
 
     }
 
@@ -42,18 +42,26 @@ using Poco::Util::HelpFormatter;
 #include "handlers/interface/handler_factory.h"
 
 #include "../../shared/errors.h"
+#include "../../shared/admission_control.h"
 
 class HTTPRequestFactory: public HTTPRequestHandlerFactory
 {
 public:
-    explicit HTTPRequestFactory(std::string format): format_(std::move(format)) { }
+    HTTPRequestFactory(std::string format, unsigned int retry_after):
+        format_(std::move(format)), retry_after_(retry_after) { }
 
     HTTPRequestHandler* createRequestHandler(const HTTPServerRequest& request) override {
 
         std::cout << "request:" << request.getURI() << std::endl;
 
+        if ( search_service::AdmissionControl::Instance().IsOverloaded() ) {
+            return new search_service::ShedRequestHandler(retry_after_);
+        }
+
         try {
-            return handler::HandlerFactory::Create(format_, request.getURI());
+            return new search_service::MeteredRequestHandler(
+                    handler::HandlerFactory::Create(format_, request.getURI())
+            );
         } catch ( const exceptions::BadURI& e ) {
             std::cout << "Failed request handler create: " << e.what() << std::endl;
         }
@@ -63,6 +71,7 @@ public:
 
 private:
     std::string format_;
+    unsigned int retry_after_;
 };
 
 #endif
\ No newline at end of file
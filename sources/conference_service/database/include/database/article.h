@@ -4,11 +4,14 @@
 #include <Poco/JSON/Object.h>
 #include <string>
 #include <optional>
+#include <vector>
 
 namespace database {
 
     class Article {
         friend class Database;
+        friend class MySqlArticleStorage;
+        friend class MemoryArticleStorage;
     public:
         static Article FromJSON(const std::string & str);
 
@@ -24,6 +27,7 @@ namespace database {
 
         static std::optional<Article> SearchByID(long id);
         static std::vector<Article> ReadAll();
+        static std::vector<Article> ReadPage(size_t limit, size_t offset);
         static bool DeleteByID(long id);
 
         void InsertToDatabase();
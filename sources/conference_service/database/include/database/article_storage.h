@@ -0,0 +1,76 @@
+#ifndef SERVER_DATABASE_ARTICLE_STORAGE_H
+#define SERVER_DATABASE_ARTICLE_STORAGE_H
+
+#include "article.h"
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+namespace database {
+
+    /**
+     * @brief Хранилище принятых статей, на которое опираются статические методы Article.
+     * @details Реализация выбирается один раз при старте сервиса, до приема запросов.
+     */
+    class ArticleStorage {
+    public:
+        virtual ~ArticleStorage() = default;
+
+        static ArticleStorage& Instance();
+
+        /* Подмена хранилища, по умолчанию используется MySqlArticleStorage */
+        static void Use(std::unique_ptr<ArticleStorage> storage);
+
+        virtual void Init() = 0;
+
+        virtual std::vector<Article> ReadAll() = 0;
+        virtual std::vector<Article> ReadPage(size_t limit, size_t offset) = 0;
+
+        /* Поиск по id статьи в articles_service, а не по id записи о принятии */
+        virtual std::optional<Article> SearchByID(long article_id) = 0;
+        virtual bool DeleteByID(long id) = 0;
+
+        /* Проставляет записи id */
+        virtual void Insert(Article& article) = 0;
+    };
+
+    class MySqlArticleStorage : public ArticleStorage {
+    public:
+        void Init() override;
+
+        std::vector<Article> ReadAll() override;
+        std::vector<Article> ReadPage(size_t limit, size_t offset) override;
+        std::optional<Article> SearchByID(long article_id) override;
+        bool DeleteByID(long id) override;
+
+        void Insert(Article& article) override;
+    };
+
+    /**
+     * @brief Хранилище в памяти процесса для запуска сервиса без БД.
+     * @details id выдаются с единицы, как AUTO_INCREMENT, и растут вместе с датой
+     * принятия, поэтому порядок страниц совпадает с ORDER BY accept_date, id.
+     */
+    class MemoryArticleStorage : public ArticleStorage {
+    public:
+        void Init() override;
+
+        std::vector<Article> ReadAll() override;
+        std::vector<Article> ReadPage(size_t limit, size_t offset) override;
+        std::optional<Article> SearchByID(long article_id) override;
+        bool DeleteByID(long id) override;
+
+        void Insert(Article& article) override;
+
+    private:
+        mutable std::shared_mutex mtx_;
+        long next_id_{ 1 };
+        std::map<long, Article> rows_;
+    };
+
+} // namespace database
+
+#endif //SERVER_DATABASE_ARTICLE_STORAGE_H
@@ -1,40 +1,11 @@
 #include "database/article.h"
 
-#include "database/database.h"
+#include "database/article_storage.h"
 
-#include <Poco/Data/MySQL/Connector.h>
-#include <Poco/Data/MySQL/MySQLException.h>
-#include <Poco/Data/SessionFactory.h>
 #include <Poco/JSON/Parser.h>
 #include <Poco/Dynamic/Var.h>
 
-using namespace Poco::Data::Keywords;
-using Poco::Data::Session;
-using Poco::Data::Statement;
-
-#define TABLE_NAME "AcceptedArticles"
-#define CREATE_TABLE_REQUEST                                        \
-    "CREATE TABLE IF NOT EXISTS `" TABLE_NAME "` "                  \
-    "("                                                             \
-        "`id` " "INT " "NOT NULL " "AUTO_INCREMENT, "               \
-        "`article_id` " "INT " "NOT NULL,"                                  \
-        "`acceptor_id` " "INT " "NOT NULL, "                        \
-        "`accept_date` " "DATETIME " "DEFAULT CURRENT_TIMESTAMP, "  \
-        "PRIMARY KEY (`id`)"                                        \
-    ");"
-
-#define SELECT_ALL_ID_REQUEST \
-    "SELECT id, article_id, acceptor_id, accept_date FROM " TABLE_NAME
-
-#define SELECT_BY_ID_REQUEST SELECT_ALL_ID_REQUEST " WHERE article_id=?"
-
-#define INSERT_ARTICLE_REQUEST \
-    "INSERT INTO " TABLE_NAME " " \
-    "(article_id, acceptor_id) " \
-    "VALUES(?, ?)"
-
-#define DELETE_BY_ID_REQUEST \
-    "DELETE FROM " TABLE_NAME " WHERE id=?"
+#include <iostream>
 
 namespace database {
 
@@ -59,152 +30,29 @@ namespace database {
     long &Article::ArticleID() noexcept { return article_id_; }
 
     void Article::Init() {
-        try {
-            Poco::Data::Session session = database::Database::Instance().CreateSession();
-            Statement create_statement(session);
-
-            create_statement << CREATE_TABLE_REQUEST, now;
-        } catch (Poco::Data::MySQL::ConnectionException& e) {
-            std::cerr << "Connection to database failed: " << e.what() << std::endl;
-            throw;
-        } catch (Poco::Data::MySQL::StatementException &e) {
-            std::cerr << "Statement exception: " << e.what() << std::endl;
-            throw;
-        }
+        ArticleStorage::Instance().Init();
     }
 
     std::vector<Article> Article::ReadAll() {
-        try
-        {
-            Poco::Data::Session session = database::Database::Instance().CreateSession();
-            Statement select(session);
-
-            Article article;
-            std::vector<Article> result;
-
-            Poco::DateTime accept_date;
-            select << SELECT_ALL_ID_REQUEST,
-                    into(article.id_),
-                    into(article.article_id_),
-                    into(article.acceptor_id_),
-                    into(accept_date),
-                    range(0, 1); //  iterate over result set one row at a time
-
-            while (!select.done()) {
-                if (select.execute()) {
-                    Poco::DateTimeFormatter formatter;
-                    article.accept_date_ = formatter.format(accept_date, "%f %b %Y, %H:%M:%S");
-                    result.push_back(article);
-                }
-            }
-
-            return result;
-        }
-        catch (Poco::Data::MySQL::ConnectionException &e) {
-            std::cerr << "Connection to DB error: " << e.what() << std::endl;
-            throw;
-        }
-        catch (Poco::Data::MySQL::StatementException &e) {
-            std::cerr << "Statement error: " << e.what() << std::endl;
-            throw;
-        }
+        return ArticleStorage::Instance().ReadAll();
+    }
+
+    /* Страница принятых статей в порядке принятия */
+    std::vector<Article> Article::ReadPage(size_t limit, size_t offset) {
+        return ArticleStorage::Instance().ReadPage(limit, offset);
     }
 
     std::optional<Article> Article::SearchByID(long id) {
-        try {
-            Poco::Data::Session session = database::Database::Instance().CreateSession();
-            Statement select(session);
-
-            Article article;
-
-            Poco::DateTime accept_date;
-            select << SELECT_BY_ID_REQUEST,
-                    into(article.id_),
-                    into(article.article_id_),
-                    into(article.acceptor_id_),
-                    into(accept_date),
-                    use(id);
-
-            size_t selected_rows = select.execute();
-
-            Poco::DateTimeFormatter formatter;
-            article.accept_date_ = formatter.format(accept_date, "%f %b %Y, %H:%M:%S");
-
-            if ( selected_rows > 0 ) {
-                return article;
-            }
-
-            return { };
-        }
-
-        catch (Poco::Data::MySQL::ConnectionException &e) {
-            std::cerr << "Connection to DB error: " << e.what() << std::endl;
-            throw;
-        }
-        catch (Poco::Data::MySQL::StatementException &e) {
-            std::cerr << "Statement error: " << e.what() << std::endl;
-            throw;
-        }
+        return ArticleStorage::Instance().SearchByID(id);
     }
 
     bool Article::DeleteByID(long id) {
-        try {
-            Poco::Data::Session session = database::Database::Instance().CreateSession();
-            Statement delete_stm(session);
-
-            delete_stm << DELETE_BY_ID_REQUEST, use(id);
-
-            size_t deleted_rows = delete_stm.execute();
-
-            if ( deleted_rows > 0 ) {
-                return true;
-            }
-
-            return false;
-        }
-
-        catch (Poco::Data::MySQL::ConnectionException &e) {
-            std::cerr << "Connection to DB error: " << e.what() << std::endl;
-            throw;
-        }
-        catch (Poco::Data::MySQL::StatementException &e) {
-            std::cerr << "Statement error: " << e.what() << std::endl;
-            throw;
-        }
+        return ArticleStorage::Instance().DeleteByID(id);
     }
 
     void Article::InsertToDatabase() {
-        try
-        {
-            Poco::Data::Session session = database::Database::Instance().CreateSession();
-            Poco::Data::Statement insert(session);
-
-            insert << INSERT_ARTICLE_REQUEST, use(article_id_), use(acceptor_id_);
-
-            insert.execute();
-
-            Poco::Data::Statement select(session);
-            select << "SELECT LAST_INSERT_ID()",
-                    into(id_),
-                    range(0, 1); //  iterate over result set one row at a time
-
-            if (!select.done()) {
-                select.execute();
-            }
-
-            std::cout << "Inserted to DB: " << id_ << std::endl;
-        }
-        catch (Poco::Data::MySQL::ConnectionException &e)
-        {
-            std::cerr << "Connection to DB error: " << e.what() << std::endl;
-            throw;
-        }
-        catch (Poco::Data::MySQL::StatementException &e)
-        {
-
-            std::cerr << "Statement error: " << e.what() << std::endl;
-            throw;
-        }
+        ArticleStorage::Instance().Insert(*this);
+        std::cout << "Inserted to DB: " << id_ << std::endl;
     }
 
     Poco::JSON::Object::Ptr Article::ToJSON() const {
@@ -0,0 +1,82 @@
+#include "database/article_storage.h"
+
+#include <Poco/DateTime.h>
+#include <Poco/DateTimeFormatter.h>
+
+#include <iostream>
+#include <iterator>
+#include <mutex>
+
+namespace {
+
+    std::unique_ptr<database::ArticleStorage>& CurrentStorage() {
+        static std::unique_ptr<database::ArticleStorage> storage = std::make_unique<database::MySqlArticleStorage>();
+        return storage;
+    }
+
+} // namespace [ Functions ]
+
+namespace database {
+
+    ArticleStorage& ArticleStorage::Instance() {
+        return *CurrentStorage();
+    }
+
+    void ArticleStorage::Use(std::unique_ptr<ArticleStorage> storage) {
+        CurrentStorage() = std::move(storage);
+    }
+
+    void MemoryArticleStorage::Init() {
+        std::cout << "Accepted articles are kept in memory" << std::endl;
+    }
+
+    std::vector<Article> MemoryArticleStorage::ReadAll() {
+        std::shared_lock<std::shared_mutex> lck(mtx_);
+
+        std::vector<Article> result;
+        result.reserve(rows_.size());
+        for ( const auto& row : rows_ ) {
+            result.push_back(row.second);
+        }
+        return result;
+    }
+
+    std::vector<Article> MemoryArticleStorage::ReadPage(size_t limit, size_t offset) {
+        std::shared_lock<std::shared_mutex> lck(mtx_);
+
+        std::vector<Article> result;
+        if ( offset >= rows_.size() ) return result;
+
+        auto it = std::next(rows_.begin(), static_cast<std::ptrdiff_t>(offset));
+        for ( ; it != rows_.end() && result.size() < limit; ++it ) {
+            result.push_back(it->second);
+        }
+        return result;
+    }
+
+    std::optional<Article> MemoryArticleStorage::SearchByID(long article_id) {
+        std::shared_lock<std::shared_mutex> lck(mtx_);
+
+        for ( const auto& row : rows_ ) {
+            if ( row.second.article_id_ == article_id ) {
+                return row.second;
+            }
+        }
+        return { };
+    }
+
+    bool MemoryArticleStorage::DeleteByID(long id) {
+        std::unique_lock<std::shared_mutex> lck(mtx_);
+        return rows_.erase(id) > 0;
+    }
+
+    void MemoryArticleStorage::Insert(Article& article) {
+        Poco::DateTimeFormatter formatter;
+        article.accept_date_ = formatter.format(Poco::DateTime(), "%f %b %Y, %H:%M:%S");
+
+        std::unique_lock<std::shared_mutex> lck(mtx_);
+        article.id_ = next_id_++;
+        rows_.emplace(article.id_, article);
+    }
+
+} // namespace database
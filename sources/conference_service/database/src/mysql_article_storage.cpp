@@ -0,0 +1,256 @@
+#include "database/article_storage.h"
+
+#include "database/database.h"
+
+#include <Poco/Data/MySQL/Connector.h>
+#include <Poco/Data/MySQL/MySQLException.h>
+#include <Poco/Data/SessionFactory.h>
+#include <Poco/DateTimeFormatter.h>
+
+#include <iostream>
+
+#include "schema_migrations.h"
+
+using namespace Poco::Data::Keywords;
+using Poco::Data::Session;
+using Poco::Data::Statement;
+
+#define TABLE_NAME "AcceptedArticles"
+#define CREATE_TABLE_REQUEST                                        \
+    "CREATE TABLE IF NOT EXISTS `" TABLE_NAME "` "                  \
+    "("                                                             \
+        "`id` " "INT " "NOT NULL " "AUTO_INCREMENT, "               \
+        "`article_id` " "INT " "NOT NULL,"                                  \
+        "`acceptor_id` " "INT " "NOT NULL, "                        \
+        "`accept_date` " "DATETIME " "DEFAULT CURRENT_TIMESTAMP, "  \
+        "PRIMARY KEY (`id`)"                                        \
+    ");"
+
+#define SELECT_ALL_ID_REQUEST \
+    "SELECT id, article_id, acceptor_id, accept_date FROM " TABLE_NAME
+
+#define SELECT_BY_ID_REQUEST SELECT_ALL_ID_REQUEST " WHERE article_id=?"
+
+#define SELECT_PAGE_REQUEST SELECT_ALL_ID_REQUEST " ORDER BY accept_date, id LIMIT ? OFFSET ?"
+
+#define INSERT_ARTICLE_REQUEST \
+    "INSERT INTO " TABLE_NAME " " \
+    "(article_id, acceptor_id) " \
+    "VALUES(?, ?)"
+
+#define DELETE_BY_ID_REQUEST \
+    "DELETE FROM " TABLE_NAME " WHERE id=?"
+
+namespace {
+
+    /**
+     * Индексы и прочие изменения схемы после CREATE TABLE. Уже примененные версии
+     * не выполняются повторно, новые добавляются в конец списка.
+     */
+    const std::vector<search_service::Migration>& ArticleMigrations() {
+        static const std::vector<search_service::Migration> migrations = {
+            { 1, "keyset order for the accepted articles page",
+              { search_service::OnlineAddIndex(TABLE_NAME, "accept_date_idx", "`accept_date`, `id`") } },
+            { 2, "lookup of acceptance by article id",
+              { search_service::OnlineAddIndex(TABLE_NAME, "article_id_idx", "`article_id`") } },
+        };
+        return migrations;
+    }
+
+} // namespace [ Functions ]
+
+namespace database {
+
+    void MySqlArticleStorage::Init() {
+        try {
+            Poco::Data::Session session = database::Database::Instance().CreateSession();
+            Statement create_statement(session);
+
+            create_statement << CREATE_TABLE_REQUEST, now;
+
+            search_service::MigrationRunner(TABLE_NAME, ArticleMigrations()).Apply(session);
+        } catch (Poco::Data::MySQL::ConnectionException& e) {
+            std::cerr << "Connection to database failed: " << e.what() << std::endl;
+            throw;
+        } catch (Poco::Data::MySQL::StatementException &e) {
+            std::cerr << "Statement exception: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    std::vector<Article> MySqlArticleStorage::ReadAll() {
+        try
+        {
+            Poco::Data::Session session = database::Database::Instance().CreateReadSession();
+            Statement select(session);
+
+            Article article;
+            std::vector<Article> result;
+
+            Poco::DateTime accept_date;
+            select << SELECT_ALL_ID_REQUEST,
+                    into(article.id_),
+                    into(article.article_id_),
+                    into(article.acceptor_id_),
+                    into(accept_date),
+                    range(0, 1); //  iterate over result set one row at a time
+
+            while (!select.done()) {
+                if (select.execute()) {
+                    Poco::DateTimeFormatter formatter;
+                    article.accept_date_ = formatter.format(accept_date, "%f %b %Y, %H:%M:%S");
+                    result.push_back(article);
+                }
+            }
+
+            return result;
+        }
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cerr << "Connection to DB error: " << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cerr << "Statement error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    /* Строки извлекаются одним вызовом execute в векторы, а не по одной */
+    std::vector<Article> MySqlArticleStorage::ReadPage(size_t limit, size_t offset) {
+        try
+        {
+            Poco::Data::Session session = database::Database::Instance().CreateReadSession();
+            Statement select(session);
+
+            std::vector<long> ids;
+            std::vector<long> article_ids;
+            std::vector<long> acceptor_ids;
+            std::vector<Poco::DateTime> accept_dates;
+
+            Poco::UInt64 limit_value = limit;
+            Poco::UInt64 offset_value = offset;
+            select << SELECT_PAGE_REQUEST,
+                    into(ids),
+                    into(article_ids),
+                    into(acceptor_ids),
+                    into(accept_dates),
+                    use(limit_value),
+                    use(offset_value);
+
+            select.execute();
+
+            std::vector<Article> result(ids.size());
+            Poco::DateTimeFormatter formatter;
+            for ( size_t i = 0; i < ids.size(); i++ ) {
+                result[i].id_ = ids[i];
+                result[i].article_id_ = article_ids[i];
+                result[i].acceptor_id_ = acceptor_ids[i];
+                result[i].accept_date_ = formatter.format(accept_dates[i], "%f %b %Y, %H:%M:%S");
+            }
+
+            return result;
+        }
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cerr << "Connection to DB error: " << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cerr << "Statement error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    std::optional<Article> MySqlArticleStorage::SearchByID(long id) {
+        try {
+            Poco::Data::Session session = database::Database::Instance().CreateReadSession();
+            Statement select(session);
+
+            Article article;
+
+            Poco::DateTime accept_date;
+            select << SELECT_BY_ID_REQUEST,
+                    into(article.id_),
+                    into(article.article_id_),
+                    into(article.acceptor_id_),
+                    into(accept_date),
+                    use(id);
+
+            size_t selected_rows = select.execute();
+
+            Poco::DateTimeFormatter formatter;
+            article.accept_date_ = formatter.format(accept_date, "%f %b %Y, %H:%M:%S");
+
+            if ( selected_rows > 0 ) {
+                return article;
+            }
+
+            return { };
+        }
+
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cerr << "Connection to DB error: " << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cerr << "Statement error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    bool MySqlArticleStorage::DeleteByID(long id) {
+        try {
+            Poco::Data::Session session = database::Database::Instance().CreateSession();
+            Statement delete_stm(session);
+
+            delete_stm << DELETE_BY_ID_REQUEST, use(id);
+
+            size_t deleted_rows = delete_stm.execute();
+            database::Database::Instance().NoteWrite();
+
+            return deleted_rows > 0;
+        }
+
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cerr << "Connection to DB error: " << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cerr << "Statement error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    void MySqlArticleStorage::Insert(Article& article) {
+        try
+        {
+            Poco::Data::Session session = database::Database::Instance().CreateSession();
+            Poco::Data::Statement insert(session);
+
+            insert << INSERT_ARTICLE_REQUEST, use(article.article_id_), use(article.acceptor_id_);
+
+            insert.execute();
+            database::Database::Instance().NoteWrite();
+
+            Poco::Data::Statement select(session);
+            select << "SELECT LAST_INSERT_ID()",
+                    into(article.id_),
+                    range(0, 1); //  iterate over result set one row at a time
+
+            if (!select.done()) {
+                select.execute();
+            }
+        }
+        catch (Poco::Data::MySQL::ConnectionException &e)
+        {
+            std::cerr << "Connection to DB error: " << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e)
+        {
+
+            std::cerr << "Statement error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+} // namespace database
@@ -7,6 +7,9 @@
 #include "database/user_role.h"
 #include "database/article.h"
 
+#include "../../../../shared/etag.h"
+#include "../../../../shared/errors.h"
+
 #include <string>
 #include <vector>
 
@@ -32,6 +35,10 @@ namespace handler {
                 SetBadRequestResponse(response, "Service unsupported this method for /article URI.");
             }
 
+        } catch (const exceptions::DeadlineExceeded& e) {
+
+            SetGatewayTimeoutResponse(response, e.what());
+
         } catch (const std::exception &e) {
 
             std::string error_desc{"Server end of work with exception: "};
@@ -75,6 +82,11 @@ namespace handler {
             return;
         }
 
+        auto json_article = article->ToJSON();
+        if ( SetNotModifiedResponse(request, response, search_service::MakeETag(json_article)) ) {
+            return;
+        }
+
         response.setStatus(Poco::Net::HTTPResponse::HTTPStatus::HTTP_OK);
         response.setChunkedTransferEncoding(true);
         response.setContentType("application/json");
@@ -83,10 +95,9 @@ namespace handler {
         root->set("title", "OK");
         root->set("status", Poco::Net::HTTPResponse::HTTP_REASON_OK);
         root->set("instance", "/article");
-        root->set("article", article->ToJSON());
+        root->set("article", json_article);
 
-        std::ostream &ostr = response.send();
-        Poco::JSON::Stringifier::stringify(root, ostr);
+        SendJSON(request, response, root);
 
     }
 
@@ -150,8 +161,7 @@ namespace handler {
         root->set("instance", "/article");
         root->set("id", article.GetID());
 
-        std::ostream &ostr = response.send();
-        Poco::JSON::Stringifier::stringify(root, ostr);
+        SendJSON(request, response, root);
 
     }
 
@@ -209,8 +219,7 @@ namespace handler {
         root->set("instance", "/article");
         root->set("id", article_id);
 
-        std::ostream &ostr = response.send();
-        Poco::JSON::Stringifier::stringify(root, ostr);
+        SendJSON(request, response, root);
     }
 
 } // namespace handler
\ No newline at end of file
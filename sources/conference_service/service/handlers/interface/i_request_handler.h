@@ -3,11 +3,15 @@
 
 #include "handler_type.h"
 
+#include <map>
 #include <optional>
+#include <vector>
 
 #include "Poco/Net/HTTPRequestHandler.h"
 #include "Poco/Net/HTTPServerRequest.h"
 #include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Dynamic/Var.h"
+#include "Poco/JSON/Object.h"
 
 using Poco::Net::HTTPRequestHandler;
 using Poco::Net::HTTPServerRequest;
@@ -31,6 +35,9 @@ namespace handler {
 
         std::string& GetFormat() noexcept;
 
+        /* 304. Выставляет ETag и отвечает 304, если If-None-Match запроса совпал с ним. */
+        bool SetNotModifiedResponse(HTTPServerRequest& request, HTTPServerResponse& response, const std::string& etag);
+
         /* 400 */
         void SetBadRequestResponse(HTTPServerResponse& response, const std::string& description);
 
@@ -49,12 +56,27 @@ namespace handler {
         /* 500 */
         void SetInternalErrorResponse(HTTPServerResponse& response, const std::string& description);
 
+        /* 503. Зависимость недоступна, повтор не раньше retry_after секунд. */
+        void SetServiceUnavailableResponse(HTTPServerResponse& response, const std::string& description,
+                                           unsigned int retry_after);
+
+        /* 504. Срок запроса истёк до получения ответа. */
+        void SetGatewayTimeoutResponse(HTTPServerResponse& response, const std::string& description);
+
+        /* Отправка JSON тела ответа со сжатием по Accept-Encoding */
+        void SendJSON(HTTPServerRequest& request, HTTPServerResponse& response, const Poco::Dynamic::Var& json);
+
         std::optional<std::pair<std::string, long>>
         AuthRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response);
 
         std::optional<bool>
         CheckArticleExistsRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response, long id);
 
+        /* Краткие данные статей (title, consumer_id) из articles_service одним запросом */
+        std::optional<std::map<long, Poco::JSON::Object::Ptr>>
+        FetchArticleSummariesRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response,
+                                     const std::vector<long>& ids);
+
     private:
         std::string format_;
         HandlerType type_;
@@ -6,18 +6,30 @@
 #include <Poco/Net/HTMLForm.h>
 #include <Poco/Net/HTTPClientSession.h>
 #include <Poco/Base64Decoder.h>
+#include <Poco/NumberParser.h>
 #include <Poco/URI.h>
 
 #include "database/database.h"
 #include "database/user_role.h"
 #include "database/article.h"
 
+#include "../../../../shared/errors.h"
+
+#include <algorithm>
 #include <iostream>
+#include <map>
 #include <string>
 #include <vector>
 
 using Poco::Net::HTMLForm;
 
+namespace {
+
+    constexpr const size_t kDefaultPageSize = 20;
+    constexpr const size_t kMaxPageSize = 100;
+
+} // namespace [ Constants ]
+
 namespace handler {
 
     SearchHandler::SearchHandler(const std::string &format) :
@@ -31,6 +43,10 @@ namespace handler {
                 SetBadRequestResponse(response, "Service unsupported this method for /search URI.");
             }
 
+        } catch (const exceptions::DeadlineExceeded& e) {
+
+            SetGatewayTimeoutResponse(response, e.what());
+
         } catch (const std::exception& e) {
 
             std::string error_desc{ "Server end of work with exception: " };
@@ -62,8 +78,41 @@ namespace handler {
 
         HTMLForm form(request);
 
+        size_t limit = kDefaultPageSize;
+        size_t offset = 0;
+        if ( form.has("limit") ) {
+            unsigned int value;
+            if ( !Poco::NumberParser::tryParseUnsigned(form.get("limit"), value) || value == 0 ) {
+                SetBadRequestResponse(response, "Wrong limit value.");
+                return;
+            }
+            limit = std::min<size_t>(value, kMaxPageSize);
+        }
+        if ( form.has("offset") ) {
+            unsigned int value;
+            if ( !Poco::NumberParser::tryParseUnsigned(form.get("offset"), value) ) {
+                SetBadRequestResponse(response, "Wrong offset value.");
+                return;
+            }
+            offset = value;
+        }
+        bool hydrate = form.has("hydrate") && form.get("hydrate") != "false" && form.get("hydrate") != "0";
 
-        auto articles = database::Article::ReadAll();
+        auto articles = database::Article::ReadPage(limit, offset);
+
+        std::map<long, Poco::JSON::Object::Ptr> summaries;
+        if ( hydrate ) {
+            std::vector<long> article_ids;
+            article_ids.reserve(articles.size());
+            for ( const auto& article : articles ) {
+                article_ids.push_back(article.GetArticleID());
+            }
+
+            auto fetched = FetchArticleSummariesRequest(request, response, article_ids);
+            if ( !fetched.has_value() )
+                return;
+            summaries = std::move(fetched.value());
+        }
 
         response.setStatus(Poco::Net::HTTPResponse::HTTPStatus::HTTP_OK);
         response.setChunkedTransferEncoding(true);
@@ -72,16 +121,26 @@ namespace handler {
         root->set("type", "/success");
         root->set("title", "OK");
         root->set("status", Poco::Net::HTTPResponse::HTTP_REASON_OK);
-        root->set("instance", "/article");
+        root->set("instance", "/search");
+        root->set("limit", limit);
+        root->set("offset", offset);
+        if ( articles.size() == limit ) {
+            root->set("next_offset", offset + limit);
+        }
 
         Poco::JSON::Array arr;
         for ( auto& article : articles ) {
-            arr.add(article);
+            auto json_article = article.ToJSON();
+            auto summary = summaries.find(article.GetArticleID());
+            if ( summary != summaries.end() ) {
+                json_article->set("title", summary->second->get("title"));
+                json_article->set("consumer_id", summary->second->get("consumer_id"));
+            }
+            arr.add(json_article);
         }
         root->set("articles", arr);
 
-        std::ostream &ostr = response.send();
-        Poco::JSON::Stringifier::stringify(root, ostr);
+        SendJSON(request, response, root);
 
     }
 
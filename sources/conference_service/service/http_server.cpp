@@ -2,6 +2,7 @@
 
 #include "database/database.h"
 #include "database/article.h"
+#include "database/article_storage.h"
 
 #include <iostream>
 
@@ -35,8 +36,11 @@ namespace search_service {
             }
             config_ = std::make_shared<search_service::Config>(args[0]);
             auto network_config = config_->GetNetworkConfig();
-            if ( !database::Database::Instance().IsConnected() ) {
-                database::Database::Instance().BindConfigure(config_->GetDatabaseConfig());
+            auto database_config = config_->GetDatabaseConfig();
+            if ( database_config->IsMemoryStorage() ) {
+                database::ArticleStorage::Use(std::make_unique<database::MemoryArticleStorage>());
+            } else if ( !database::Database::Instance().IsConnected() ) {
+                database::Database::Instance().BindConfigure(database_config);
                 bool result = database::Database::Instance().TryConnect();
                 if ( !result ) {
                     std::cerr << "Failed connect to database." << std::endl;
@@ -46,11 +50,76 @@ namespace search_service {
 
             database::Article::Init();
 
-            ServerSocket svs(Poco::Net::SocketAddress(network_config->GetIP(), network_config->GetPort()));
-            HTTPServer srv(new HTTPRequestFactory(DateTimeFormat::SORTABLE_FORMAT), svs, new HTTPServerParams);
-            srv.start();
-            waitForTerminationRequest();
-            srv.stop();
+            auto server_config = config_->GetServerConfig();
+
+            HTTPServerParams::Ptr params = new HTTPServerParams;
+            params->setMaxThreads(static_cast<int>(server_config->GetMaxThreads()));
+            params->setMaxQueued(static_cast<int>(server_config->GetMaxQueued()));
+            params->setThreadIdleTime(Poco::Timespan(server_config->GetThreadIdleTime(), 0));
+            params->setKeepAlive(server_config->GetKeepAlive());
+            params->setMaxKeepAliveRequests(static_cast<int>(server_config->GetMaxKeepAliveRequests()));
+            params->setKeepAliveTimeout(Poco::Timespan(server_config->GetKeepAliveTimeout(), 0));
+            params->setTimeout(Poco::Timespan(server_config->GetTimeout(), 0));
+
+            AdmissionControl::Instance().Configure(
+                    server_config->GetMaxThreads(),
+                    server_config->GetMaxQueueWait(),
+                    server_config->GetMaxPoolWait()
+            );
+
+            RequestDeadline::Instance().Configure(server_config->GetRequestTimeoutMs());
+
+            CircuitBreakerOptions downstream_options{
+                    server_config->GetDownstreamBreakerFailures(),
+                    server_config->GetDownstreamBreakerOpenMs(),
+                    server_config->GetDownstreamTimeoutMs()
+            };
+            CircuitBreaker::Configure(kUsersServiceBreaker, downstream_options);
+            CircuitBreaker::Configure(kArticlesServiceBreaker, downstream_options);
+
+            ResponseCompression::Instance().Configure(
+                    server_config->GetCompression(),
+                    server_config->GetCompressionMinSize(),
+                    server_config->GetCompressionLevel()
+            );
+
+            ServerSocket svs;
+            svs.bind(Poco::Net::SocketAddress(network_config->GetIP(), network_config->GetPort()),
+                     server_config->GetReuseAddress(),
+                     server_config->GetReusePort());
+            svs.listen(static_cast<int>(server_config->GetBacklog()));
+
+            AdmissionControl::Instance().BindPoolWaitProbe([]() {
+                return database::Database::Instance().GetPoolWaitTime();
+            });
+
+            if ( server_config->IsEventLoopMode() ) {
+                EventLoopServer srv(new HTTPRequestFactory(DateTimeFormat::SORTABLE_FORMAT, server_config->GetRetryAfter()),
+                                    svs, params, server_config->GetReactorThreads());
+
+                AdmissionControl::Instance().BindQueueProbe([&srv]() { return srv.queuedConnections(); });
+
+                srv.start();
+                waitForTerminationRequest();
+                srv.stop();
+            } else {
+                Poco::ThreadPool thread_pool(
+                        static_cast<int>(server_config->GetMinThreads()),
+                        static_cast<int>(server_config->GetMaxThreads()),
+                        static_cast<int>(server_config->GetThreadIdleTime())
+                );
+
+                HTTPServer srv(new HTTPRequestFactory(DateTimeFormat::SORTABLE_FORMAT, server_config->GetRetryAfter()),
+                               thread_pool, svs, params);
+
+                AdmissionControl::Instance().BindQueueProbe([&srv]() { return srv.queuedConnections(); });
+
+                srv.start();
+                waitForTerminationRequest();
+                srv.stop();
+            }
+            AdmissionControl::Instance().UnbindProbes();
+            database::Database::Instance().Shutdown();
         }
         return Application::EXIT_OK;
     }
@@ -38,6 +38,10 @@ using Poco::Util::OptionSet;
 using Poco::Util::ServerApplication;
 
 #include "http_request_factory.h"
+#include "../../shared/event_loop_server.h"
+#include "../../shared/response_compression.h"
+#include "../../shared/circuit_breaker.h"
+#include "../../shared/request_deadline.h"
 #include "config/server_config.h"
 
 namespace search_service {
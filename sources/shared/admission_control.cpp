@@ -0,0 +1,149 @@
+#include "admission_control.h"
+#include "request_deadline.h"
+#include "read_your_writes.h"
+
+#include <Poco/JSON/Object.h>
+#include <Poco/Timestamp.h>
+
+#include <sstream>
+#include <utility>
+
+namespace {
+
+    /* Вес нового измерения в экспоненциальном скользящем среднем времени обработки */
+    constexpr const double kServiceTimeSmoothing = 0.1;
+
+} // namespace [ Constants ]
+
+namespace search_service {
+
+    AdmissionControl::AdmissionControl() :
+        max_threads_(1),
+        max_queue_wait_ms_(0),
+        max_pool_wait_ms_(0),
+        service_time_ms_(0.0) { /* Empty */ }
+
+    AdmissionControl& AdmissionControl::Instance() {
+        static AdmissionControl instance;
+        return instance;
+    }
+
+    void AdmissionControl::Configure(unsigned int max_threads, unsigned int max_queue_wait_ms, unsigned int max_pool_wait_ms) {
+        max_threads_ = max_threads == 0 ? 1 : max_threads;
+        max_queue_wait_ms_ = max_queue_wait_ms;
+        max_pool_wait_ms_ = max_pool_wait_ms;
+    }
+
+    void AdmissionControl::BindQueueProbe(std::function<int()> probe) {
+        std::lock_guard<std::mutex> lck(probes_mtx_);
+        queue_probe_ = std::move(probe);
+    }
+
+    void AdmissionControl::BindPoolWaitProbe(std::function<double()> probe) {
+        std::lock_guard<std::mutex> lck(probes_mtx_);
+        pool_wait_probe_ = std::move(probe);
+    }
+
+    void AdmissionControl::UnbindProbes() {
+        std::lock_guard<std::mutex> lck(probes_mtx_);
+        queue_probe_ = nullptr;
+        pool_wait_probe_ = nullptr;
+    }
+
+    void AdmissionControl::RecordServiceTime(double elapsed_ms) noexcept {
+        double current = service_time_ms_.load(std::memory_order_relaxed);
+        double updated = current + kServiceTimeSmoothing * (elapsed_ms - current);
+        service_time_ms_.store(updated, std::memory_order_relaxed);
+    }
+
+    double AdmissionControl::EstimateQueueWait() const {
+        std::lock_guard<std::mutex> lck(probes_mtx_);
+        if ( !queue_probe_ ) return 0.0;
+
+        int queued = queue_probe_();
+        if ( queued <= 0 ) return 0.0;
+
+        return queued * service_time_ms_.load(std::memory_order_relaxed) / max_threads_;
+    }
+
+    bool AdmissionControl::IsOverloaded() const {
+        if ( max_queue_wait_ms_ > 0 && EstimateQueueWait() > max_queue_wait_ms_ ) {
+            return true;
+        }
+
+        if ( max_pool_wait_ms_ > 0 ) {
+            std::lock_guard<std::mutex> lck(probes_mtx_);
+            if ( pool_wait_probe_ && pool_wait_probe_() > max_pool_wait_ms_ ) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+} // namespace search_service
+
+namespace search_service {
+
+    ShedRequestHandler::ShedRequestHandler(unsigned int retry_after_sec) : retry_after_sec_(retry_after_sec) { /* Empty */ }
+
+    void ShedRequestHandler::handleRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
+        response.setStatus(Poco::Net::HTTPResponse::HTTPStatus::HTTP_SERVICE_UNAVAILABLE);
+        response.setKeepAlive(false);
+        response.set("Retry-After", std::to_string(retry_after_sec_));
+        response.setContentType("application/json");
+        Poco::JSON::Object::Ptr root = new Poco::JSON::Object();
+        root->set("type", "/errors/service_unavailable");
+        root->set("title", "Service unavailable.");
+        root->set("status", Poco::Net::HTTPResponse::HTTP_REASON_SERVICE_UNAVAILABLE);
+        root->set("detail", "Server is overloaded. Retry later.");
+        root->set("instance", request.getURI());
+
+        std::ostringstream oss;
+        Poco::JSON::Stringifier::stringify(root, oss);
+        std::string body = oss.str();
+        response.sendBuffer(body.data(), body.size());
+    }
+
+} // namespace search_service
+
+namespace {
+
+    void SetDeadlineExpiredResponse(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
+        response.setStatus(Poco::Net::HTTPResponse::HTTPStatus::HTTP_GATEWAY_TIMEOUT);
+        response.setContentType("application/json");
+        Poco::JSON::Object::Ptr root = new Poco::JSON::Object();
+        root->set("type", "/errors/gateway_timeout");
+        root->set("title", "Gateway timeout.");
+        root->set("status", Poco::Net::HTTPResponse::HTTP_REASON_GATEWAY_TIMEOUT);
+        root->set("detail", "Request deadline exceeded before processing.");
+        root->set("instance", request.getURI());
+
+        std::ostringstream oss;
+        Poco::JSON::Stringifier::stringify(root, oss);
+        std::string body = oss.str();
+        response.sendBuffer(body.data(), body.size());
+    }
+
+} // namespace [ Helpers ]
+
+namespace search_service {
+
+    MeteredRequestHandler::MeteredRequestHandler(Poco::Net::HTTPRequestHandler *handler) : handler_(handler) { /* Empty */ }
+
+    void MeteredRequestHandler::handleRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
+        Poco::Timestamp start;
+        RequestDeadline::Scope deadline(RequestDeadline::Instance().Accept(request));
+        ReadYourWrites::Scope read_your_writes(request, response);
+
+        /* Вызывающий сервис уже не ждёт ответа - не тратим на запрос ни БД, ни кэш */
+        if ( RequestDeadline::Expired() ) {
+            SetDeadlineExpiredResponse(request, response);
+            return;
+        }
+
+        handler_->handleRequest(request, response);
+        AdmissionControl::Instance().RecordServiceTime(static_cast<double>(start.elapsed()) / 1000.0);
+    }
+
+} // namespace search_service
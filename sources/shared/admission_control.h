@@ -0,0 +1,79 @@
+#ifndef SERVER_ADMISSION_CONTROL_H
+#define SERVER_ADMISSION_CONTROL_H
+
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace search_service {
+
+    /**
+     * @brief Контроль допуска запросов к обработке (load shedding).
+     * @details Оценивает время ожидания соединения в очереди сервера как
+     * queued * среднее_время_обработки / max_threads и сравнивает его, а также
+     * среднее время ожидания сессии из пула БД, с порогами из конфигурации.
+     * Нулевой порог отключает соответствующую проверку.
+     */
+    class AdmissionControl {
+        AdmissionControl();
+
+    public:
+        static AdmissionControl& Instance();
+
+        void Configure(unsigned int max_threads, unsigned int max_queue_wait_ms, unsigned int max_pool_wait_ms);
+
+        void BindQueueProbe(std::function<int()> probe);
+        void BindPoolWaitProbe(std::function<double()> probe);
+        void UnbindProbes();
+
+        void RecordServiceTime(double elapsed_ms) noexcept;
+
+        [[nodiscard]] double EstimateQueueWait() const;
+        [[nodiscard]] bool IsOverloaded() const;
+
+    private:
+        unsigned int max_threads_;
+        unsigned int max_queue_wait_ms_;
+        unsigned int max_pool_wait_ms_;
+        std::atomic<double> service_time_ms_;
+
+        mutable std::mutex probes_mtx_;
+        std::function<int()> queue_probe_;
+        std::function<double()> pool_wait_probe_;
+    };
+
+    /**
+     * @brief Обработчик, сразу отвечающий 503 Service Unavailable при перегрузке.
+     */
+    class ShedRequestHandler : public Poco::Net::HTTPRequestHandler {
+    public:
+        explicit ShedRequestHandler(unsigned int retry_after_sec);
+
+        void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response) override;
+
+    private:
+        unsigned int retry_after_sec_;
+    };
+
+    /**
+     * @brief Обертка над обработчиком запроса, измеряющая время обработки для AdmissionControl.
+     * @details На время обработки потоку выставляется срок запроса (RequestDeadline).
+     */
+    class MeteredRequestHandler : public Poco::Net::HTTPRequestHandler {
+    public:
+        explicit MeteredRequestHandler(Poco::Net::HTTPRequestHandler* handler);
+
+        void handleRequest(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response) override;
+
+    private:
+        std::unique_ptr<Poco::Net::HTTPRequestHandler> handler_;
+    };
+
+} // namespace search_service
+
+#endif //SERVER_ADMISSION_CONTROL_H
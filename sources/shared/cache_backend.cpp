@@ -0,0 +1,215 @@
+#include "cache_backend.h"
+#include "request_deadline.h"
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+
+#include <Poco/Timestamp.h>
+
+#include <redis-cpp/execute.h>
+
+namespace {
+
+    constexpr const char* const kRedisBackend = "redis";
+    constexpr const char* const kMemoryBackend = "memory";
+
+} // namespace [ Constants ]
+
+namespace search_service {
+
+    RedisCacheBackend::RedisCacheBackend(std::string host, unsigned int port, unsigned int pool_size) :
+        host_(std::move(host)),
+        port_(std::to_string(port)),
+        breaker_(CircuitBreaker::Get(search_service::kCacheBreaker)) {
+        std::cout << "cache host:" << host_ << " port:" << port_ << " pool:" << pool_size << std::endl;
+
+        for ( unsigned int i = 0; i < std::max(1u, pool_size); i++ ) {
+            idle_.push_back(Connect());
+        }
+    }
+
+    void RedisCacheBackend::Set(const std::string& key, const std::string& value, unsigned int expiration_sec) {
+        Execute("put", [&](std::iostream& stream) {
+            rediscpp::execute(stream, "set", key, value, "ex", std::to_string(expiration_sec));
+        });
+    }
+
+    std::optional<std::string> RedisCacheBackend::Get(const std::string& key) {
+        std::optional<std::string> value;
+        Execute("get", [&](std::iostream& stream) {
+            rediscpp::value response = rediscpp::execute(stream, "get", key);
+            if ( !response.is_error_message() && !response.empty() ) {
+                value = response.as<std::string>();
+            }
+        });
+        return value;
+    }
+
+    void RedisCacheBackend::Remove(const std::string& key) {
+        Execute("remove", [&](std::iostream& stream) {
+            rediscpp::execute(stream, "del", key);
+        });
+    }
+
+    bool RedisCacheBackend::Execute(const char* operation, const std::function<void(std::iostream&)>& command) {
+        /* Срок запроса истёк - ответ кэша уже никому не нужен, Redis не виноват */
+        if ( RequestDeadline::Expired() ) return false;
+        if ( !breaker_.Allow() ) return false;
+
+        Poco::Timestamp start;
+
+        unsigned int timeout_ms = breaker_.GetTimeout();
+        if ( auto remaining = RequestDeadline::Remaining() ) {
+            unsigned int budget_ms = std::max(1u, *remaining);
+            timeout_ms = timeout_ms == 0 ? budget_ms : std::min(timeout_ms, budget_ms);
+        }
+
+        /* Все соединения заняты дольше таймаута - Redis не успевает отвечать */
+        Stream stream = Acquire(timeout_ms);
+        if ( !stream ) {
+            std::cerr << "Cache " << operation << " error: no free connection" << std::endl;
+            if ( RequestDeadline::Expired() ) {
+                breaker_.RecordAbandoned();
+            } else {
+                breaker_.RecordFailure();
+            }
+            return false;
+        }
+
+        bool done = false;
+        try {
+            if ( !stream->good() ) throw std::runtime_error("cache is unavailable");
+            SetExpiry(*stream, timeout_ms);
+            command(*stream);
+            /* Истекший срок сокета переводит поток в ошибку, ответ при этом не прочитан */
+            if ( !stream->good() ) throw std::runtime_error(stream->error() ? stream->error().message() : "stream failed");
+            done = true;
+        } catch ( const std::exception& e ) {
+            std::cerr << "Cache " << operation << " error: " << e.what() << std::endl;
+            stream->setstate(std::ios::badbit);
+        }
+        Release(std::move(stream));
+
+        if ( done ) {
+            breaker_.RecordSuccess(static_cast<double>(start.elapsed()) / 1000.0);
+        } else if ( RequestDeadline::Expired() ) {
+            breaker_.RecordAbandoned();
+        } else {
+            breaker_.RecordFailure();
+        }
+        return done;
+    }
+
+    bool RedisCacheBackend::IsShared() const noexcept {
+        return true;
+    }
+
+    RedisCacheBackend::Stream RedisCacheBackend::Acquire(unsigned int timeout_ms) {
+        std::unique_lock<std::mutex> lck(mtx_);
+        auto has_idle = [this]() { return !idle_.empty(); };
+        if ( timeout_ms == 0 ) {
+            released_.wait(lck, has_idle);
+        } else if ( !released_.wait_for(lck, std::chrono::milliseconds(timeout_ms), has_idle) ) {
+            return nullptr;
+        }
+
+        Stream stream = std::move(idle_.back());
+        idle_.pop_back();
+        return stream;
+    }
+
+    void RedisCacheBackend::Release(Stream stream) {
+        /* Сломанное соединение заменяется новым, чтобы пул не уменьшался */
+        if ( !stream || !stream->good() ) {
+            stream = Connect();
+        }
+
+        {
+            std::lock_guard<std::mutex> lck(mtx_);
+            idle_.push_back(std::move(stream));
+        }
+        released_.notify_one();
+    }
+
+    RedisCacheBackend::Stream RedisCacheBackend::Connect() const {
+        try {
+            auto stream = std::make_shared<boost::asio::ip::tcp::iostream>();
+            SetExpiry(*stream, breaker_.GetTimeout());
+            stream->connect(host_, port_);
+            if ( !stream->good() ) {
+                std::cerr << "Error opening cache stream: " << stream->error().message() << std::endl;
+            }
+            return stream;
+        } catch ( const std::exception& e ) {
+            std::cerr << "Error opening cache stream: " << e.what() << std::endl;
+        }
+        return nullptr;
+    }
+
+    void RedisCacheBackend::SetExpiry(boost::asio::ip::tcp::iostream& stream, unsigned int timeout_ms) {
+        if ( timeout_ms == 0 ) {
+            stream.expires_at((std::chrono::steady_clock::time_point::max)());
+        } else {
+            stream.expires_after(std::chrono::milliseconds(timeout_ms));
+        }
+    }
+
+    MemoryCacheBackend::MemoryCacheBackend(size_t max_entries) : max_entries_(max_entries) {
+        std::cout << "cache in memory, max entries:" << max_entries_ << std::endl;
+    }
+
+    void MemoryCacheBackend::Set(const std::string& key, const std::string& value, unsigned int expiration_sec) {
+        if ( max_entries_ == 0 ) return;
+
+        std::lock_guard<std::mutex> lck(mtx_);
+        auto now = Clock::now();
+
+        if ( entries_.size() >= max_entries_ && entries_.find(key) == entries_.end() ) {
+            for ( auto it = entries_.begin(); it != entries_.end(); ) {
+                it = it->second.expires_at <= now ? entries_.erase(it) : std::next(it);
+            }
+            if ( entries_.size() >= max_entries_ ) entries_.clear();
+        }
+
+        entries_[key] = Entry{ value, now + std::chrono::seconds(expiration_sec) };
+    }
+
+    std::optional<std::string> MemoryCacheBackend::Get(const std::string& key) {
+        std::lock_guard<std::mutex> lck(mtx_);
+
+        auto it = entries_.find(key);
+        if ( it == entries_.end() ) return { };
+
+        if ( it->second.expires_at <= Clock::now() ) {
+            entries_.erase(it);
+            return { };
+        }
+        return it->second.value;
+    }
+
+    void MemoryCacheBackend::Remove(const std::string& key) {
+        std::lock_guard<std::mutex> lck(mtx_);
+        entries_.erase(key);
+    }
+
+    bool MemoryCacheBackend::IsShared() const noexcept {
+        return false;
+    }
+
+    std::unique_ptr<CacheBackend> MakeCacheBackend(const std::string& kind,
+                                                   const std::string& host,
+                                                   unsigned int port,
+                                                   unsigned int pool_size,
+                                                   size_t memory_max_entries) {
+        if ( kind == kMemoryBackend ) {
+            return std::make_unique<MemoryCacheBackend>(memory_max_entries);
+        }
+        if ( kind != kRedisBackend ) {
+            std::cerr << "Unknown cache backend " << kind << ", using " << kRedisBackend << std::endl;
+        }
+        return std::make_unique<RedisCacheBackend>(host, port, pool_size);
+    }
+
+} // namespace search_service
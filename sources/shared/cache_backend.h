@@ -0,0 +1,117 @@
+#ifndef SERVER_CACHE_BACKEND_H
+#define SERVER_CACHE_BACKEND_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/ip/tcp.hpp>
+
+#include "circuit_breaker.h"
+
+namespace search_service {
+
+    /**
+     * @brief Хранилище строк с временем жизни, поверх которого работают кэши сервисов.
+     * @details Ошибки реализации наружу не выходят: чтение считается промахом, запись теряется.
+     */
+    class CacheBackend {
+    public:
+        virtual ~CacheBackend() = default;
+
+        virtual void Set(const std::string& key, const std::string& value, unsigned int expiration_sec) = 0;
+        virtual std::optional<std::string> Get(const std::string& key) = 0;
+        virtual void Remove(const std::string& key) = 0;
+
+        /* Значения видны другим экземплярам сервиса */
+        [[nodiscard]] virtual bool IsShared() const noexcept = 0;
+    };
+
+    /**
+     * @brief Redis через redis-cpp.
+     * @details Соединения берутся из пула фиксированного размера, поэтому параллельные
+     * запросы не сериализуются на одном сокете. Сломанное соединение заменяется новым.
+     * Вызовы идут через предохранитель "cache": пока Redis недоступен или отвечает
+     * дольше таймаута, обращения сразу считаются промахом и не ждут соединения.
+     * Чтение и запись в сокет ограничены тем же таймаутом, не дольше срока запроса,
+     * поэтому зависший Redis не держит поток обработки запроса.
+     */
+    class RedisCacheBackend : public CacheBackend {
+    public:
+        RedisCacheBackend(std::string host, unsigned int port, unsigned int pool_size);
+
+        void Set(const std::string& key, const std::string& value, unsigned int expiration_sec) override;
+        std::optional<std::string> Get(const std::string& key) override;
+        void Remove(const std::string& key) override;
+
+        [[nodiscard]] bool IsShared() const noexcept override;
+
+    private:
+        using Stream = std::shared_ptr<boost::asio::ip::tcp::iostream>;
+
+        /* Выполнение команды под предохранителем, false - команда не выполнена */
+        bool Execute(const char* operation, const std::function<void(std::iostream&)>& command);
+
+        Stream Acquire(unsigned int timeout_ms);
+        void Release(Stream stream);
+        Stream Connect() const;
+
+        /* Срок операций с сокетом. 0 - без ограничения */
+        static void SetExpiry(boost::asio::ip::tcp::iostream& stream, unsigned int timeout_ms);
+
+    private:
+        std::string host_;
+        std::string port_;
+        CircuitBreaker& breaker_;
+
+        std::mutex mtx_;
+        std::condition_variable released_;
+        std::vector<Stream> idle_;
+    };
+
+    /**
+     * @brief Кэш в памяти процесса для запуска одного экземпляра без Redis.
+     * @details При переполнении сначала выбрасываются устаревшие записи, затем всё целиком.
+     */
+    class MemoryCacheBackend : public CacheBackend {
+    public:
+        explicit MemoryCacheBackend(size_t max_entries);
+
+        void Set(const std::string& key, const std::string& value, unsigned int expiration_sec) override;
+        std::optional<std::string> Get(const std::string& key) override;
+        void Remove(const std::string& key) override;
+
+        [[nodiscard]] bool IsShared() const noexcept override;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Entry {
+            std::string value;
+            Clock::time_point expires_at;
+        };
+
+    private:
+        size_t max_entries_;
+
+        std::mutex mtx_;
+        std::unordered_map<std::string, Entry> entries_;
+    };
+
+    /* Реализация по имени из конфигурации: "redis" или "memory" */
+    std::unique_ptr<CacheBackend> MakeCacheBackend(const std::string& kind,
+                                                   const std::string& host,
+                                                   unsigned int port,
+                                                   unsigned int pool_size,
+                                                   size_t memory_max_entries);
+
+} // namespace search_service
+
+#endif //SERVER_CACHE_BACKEND_H
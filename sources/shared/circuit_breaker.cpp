@@ -0,0 +1,142 @@
+#include "circuit_breaker.h"
+
+#include <iostream>
+#include <map>
+
+namespace {
+
+    std::mutex registry_mtx;
+
+    std::map<std::string, std::unique_ptr<search_service::CircuitBreaker>>& Registry() {
+        static std::map<std::string, std::unique_ptr<search_service::CircuitBreaker>> registry;
+        return registry;
+    }
+
+    std::map<std::string, search_service::CircuitBreakerOptions>& ConfiguredOptions() {
+        static std::map<std::string, search_service::CircuitBreakerOptions> options;
+        return options;
+    }
+
+} // namespace [ Functions ]
+
+namespace search_service {
+
+    CircuitBreaker::CircuitBreaker(std::string name, CircuitBreakerOptions options) :
+        name_(std::move(name)),
+        options_(options),
+        state_(State::Closed),
+        failures_(0),
+        probe_in_flight_(false) { /* Empty */ }
+
+    CircuitBreaker& CircuitBreaker::Get(const std::string& name) {
+        std::lock_guard<std::mutex> lck(registry_mtx);
+
+        auto& breaker = Registry()[name];
+        if ( !breaker ) {
+            auto options = ConfiguredOptions().find(name);
+            breaker = std::make_unique<CircuitBreaker>(
+                    name, options != ConfiguredOptions().end() ? options->second : CircuitBreakerOptions{});
+        }
+        return *breaker;
+    }
+
+    void CircuitBreaker::Configure(const std::string& name, CircuitBreakerOptions options) {
+        std::lock_guard<std::mutex> lck(registry_mtx);
+
+        ConfiguredOptions()[name] = options;
+
+        auto it = Registry().find(name);
+        if ( it != Registry().end() ) {
+            std::lock_guard<std::mutex> breaker_lck(it->second->mtx_);
+            it->second->options_ = options;
+        }
+    }
+
+    bool CircuitBreaker::Allow() {
+        std::lock_guard<std::mutex> lck(mtx_);
+
+        switch ( state_ ) {
+            case State::Closed:
+                return true;
+            case State::Open:
+                if ( Clock::now() < open_until_ ) return false;
+                state_ = State::HalfOpen;
+                probe_in_flight_ = true;
+                return true;
+            case State::HalfOpen:
+                /* Пока пробный вызов не завершился, остальные получают отказ */
+                if ( probe_in_flight_ ) return false;
+                probe_in_flight_ = true;
+                return true;
+        }
+        return true;
+    }
+
+    void CircuitBreaker::RecordSuccess(double elapsed_ms) {
+        std::lock_guard<std::mutex> lck(mtx_);
+        if ( options_.timeout_ms > 0 && elapsed_ms > options_.timeout_ms ) {
+            Fail();
+            return;
+        }
+
+        if ( state_ != State::Closed ) {
+            std::cout << "Circuit breaker " << name_ << " closed" << std::endl;
+        }
+        state_ = State::Closed;
+        failures_ = 0;
+        probe_in_flight_ = false;
+    }
+
+    void CircuitBreaker::RecordFailure() {
+        std::lock_guard<std::mutex> lck(mtx_);
+        Fail();
+    }
+
+    void CircuitBreaker::RecordAbandoned() {
+        std::lock_guard<std::mutex> lck(mtx_);
+        /* Пробный вызов ничего не показал, следующий вызов станет новой пробой */
+        probe_in_flight_ = false;
+    }
+
+    CircuitBreaker::State CircuitBreaker::GetState() const {
+        std::lock_guard<std::mutex> lck(mtx_);
+        return state_;
+    }
+
+    unsigned int CircuitBreaker::GetTimeout() const {
+        std::lock_guard<std::mutex> lck(mtx_);
+        return options_.timeout_ms;
+    }
+
+    unsigned int CircuitBreaker::RetryAfter() const {
+        std::lock_guard<std::mutex> lck(mtx_);
+        if ( state_ == State::Closed ) return 0;
+
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(open_until_ - Clock::now()).count();
+        if ( left <= 0 ) return 1;
+        return static_cast<unsigned int>((left + 999) / 1000);
+    }
+
+    const std::string& CircuitBreaker::GetName() const noexcept {
+        return name_;
+    }
+
+    void CircuitBreaker::Fail() {
+        failures_++;
+
+        if ( state_ == State::HalfOpen ||
+             (state_ == State::Closed && options_.failure_threshold > 0 && failures_ >= options_.failure_threshold) ) {
+            Open();
+        }
+    }
+
+    void CircuitBreaker::Open() {
+        if ( state_ != State::Open ) {
+            std::cerr << "Circuit breaker " << name_ << " opened after " << failures_ << " failures" << std::endl;
+        }
+        state_ = State::Open;
+        probe_in_flight_ = false;
+        open_until_ = Clock::now() + std::chrono::milliseconds(options_.open_ms);
+    }
+
+} // namespace search_service
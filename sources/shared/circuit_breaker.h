@@ -0,0 +1,80 @@
+#ifndef SERVER_CIRCUIT_BREAKER_H
+#define SERVER_CIRCUIT_BREAKER_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace search_service {
+
+    /* Имена предохранителей зависимостей */
+    constexpr const char* const kCacheBreaker = "cache";
+    constexpr const char* const kUsersServiceBreaker = "users_service";
+    constexpr const char* const kArticlesServiceBreaker = "articles_service";
+
+    struct CircuitBreakerOptions {
+        /* Число неудачных вызовов подряд, после которого цепь размыкается. 0 - не размыкается никогда */
+        unsigned int failure_threshold{ 5 };
+        /* Время в разомкнутом состоянии до пробного вызова */
+        unsigned int open_ms{ 2000 };
+        /* Предел длительности вызова, более долгий вызов считается неудачным */
+        unsigned int timeout_ms{ 1000 };
+    };
+
+    /**
+     * @brief Предохранитель для вызовов внешней зависимости (Redis, соседние сервисы).
+     * @details В замкнутом состоянии вызовы проходят. После failure_threshold неудач
+     * подряд цепь размыкается, и Allow() сразу отказывает, не тратя время на таймаут.
+     * Через open_ms пропускается один пробный вызов: его успех замыкает цепь,
+     * неудача снова размыкает её на open_ms.
+     */
+    class CircuitBreaker {
+    public:
+        enum class State { Closed, Open, HalfOpen };
+
+        CircuitBreaker(std::string name, CircuitBreakerOptions options);
+
+        /* Предохранитель зависимости по имени, общий для всего процесса */
+        static CircuitBreaker& Get(const std::string& name);
+
+        /* Вызывается при старте сервиса, до первого Get с этим именем */
+        static void Configure(const std::string& name, CircuitBreakerOptions options);
+
+        [[nodiscard]] bool Allow();
+
+        void RecordSuccess(double elapsed_ms);
+        void RecordFailure();
+
+        /* Вызов прерван по сроку запроса вызывающей стороны - это не отказ зависимости */
+        void RecordAbandoned();
+
+        [[nodiscard]] State GetState() const;
+        [[nodiscard]] unsigned int GetTimeout() const;
+
+        /* Секунды до следующего пробного вызова для заголовка Retry-After */
+        [[nodiscard]] unsigned int RetryAfter() const;
+
+        [[nodiscard]] const std::string& GetName() const noexcept;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        /* Вызываются под mtx_ */
+        void Fail();
+        void Open();
+
+    private:
+        std::string name_;
+
+        mutable std::mutex mtx_;
+        CircuitBreakerOptions options_;
+        State state_;
+        unsigned int failures_;
+        bool probe_in_flight_;
+        Clock::time_point open_until_;
+    };
+
+} // namespace search_service
+
+#endif //SERVER_CIRCUIT_BREAKER_H
@@ -18,4 +18,8 @@ namespace exceptions {
     IMPLEMENT_DEFAULT_CONSTRUCTORS(BadRequest, std::runtime_error)
     IMPLEMENT_DEFAULT_CONSTRUCTORS(BadURI, BadRequest)
 
+    IMPLEMENT_DEFAULT_CONSTRUCTORS(Conflict, std::runtime_error)
+
+    IMPLEMENT_DEFAULT_CONSTRUCTORS(DeadlineExceeded, std::runtime_error)
+
 } // namespace exceptions
\ No newline at end of file
@@ -25,6 +25,10 @@ namespace exceptions {
     REGISTER_EXCEPTION_TYPE(BadRequest, std::runtime_error);
     REGISTER_EXCEPTION_TYPE(BadURI, BadRequest);
 
+    REGISTER_EXCEPTION_TYPE(Conflict, std::runtime_error);
+
+    REGISTER_EXCEPTION_TYPE(DeadlineExceeded, std::runtime_error);
+
 } // namespace exceptions
 
 #endif //SERVER_ERRORS_H
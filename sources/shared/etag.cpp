@@ -0,0 +1,62 @@
+#include "etag.h"
+
+#include "Poco/DigestStream.h"
+#include "Poco/JSON/Stringifier.h"
+#include "Poco/SHA1Engine.h"
+#include "Poco/StringTokenizer.h"
+
+namespace {
+
+    constexpr const char* const kWeakPrefix = "W/";
+
+    /* Кодировки, которые может выбрать ResponseCompression */
+    constexpr const char* const kCodingSuffixes[] = { "-gzip", "-deflate" };
+
+} // namespace [ Constants ]
+
+namespace {
+
+    /* "<sha1>-gzip" -> "<sha1>" */
+    std::string WithoutContentCoding(const std::string& tag) {
+        if ( tag.size() < 2 || tag.back() != '"' ) return tag;
+
+        std::string opaque = tag.substr(0, tag.size() - 1);
+        for ( const std::string suffix : kCodingSuffixes ) {
+            if ( opaque.size() > suffix.size() &&
+                 opaque.compare(opaque.size() - suffix.size(), suffix.size(), suffix) == 0 ) {
+                return opaque.substr(0, opaque.size() - suffix.size()) + "\"";
+            }
+        }
+        return tag;
+    }
+
+} // namespace [ Functions ]
+
+namespace search_service {
+
+    std::string MakeETag(const Poco::Dynamic::Var& json) {
+        Poco::SHA1Engine engine;
+        Poco::DigestOutputStream digest(engine);
+        Poco::JSON::Stringifier::stringify(json, digest);
+        digest.close();
+
+        return "\"" + Poco::DigestEngine::digestToHex(engine.digest()) + "\"";
+    }
+
+    std::string WithContentCoding(const std::string& etag, const std::string& coding) {
+        if ( etag.size() < 2 || etag.back() != '"' ) return etag;
+        return etag.substr(0, etag.size() - 1) + "-" + coding + "\"";
+    }
+
+    std::optional<std::string> MatchIfNoneMatch(const std::string& if_none_match, const std::string& etag) {
+        Poco::StringTokenizer tags(if_none_match, ",",
+                                   Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+        for ( std::string tag : tags ) {
+            if ( tag == "*" ) return etag;
+            if ( tag.rfind(kWeakPrefix, 0) == 0 ) tag.erase(0, 2);
+            if ( WithoutContentCoding(tag) == etag ) return tag;
+        }
+        return std::nullopt;
+    }
+
+} // namespace search_service
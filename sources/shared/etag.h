@@ -0,0 +1,33 @@
+#ifndef SERVER_ETAG_H
+#define SERVER_ETAG_H
+
+#include "Poco/Dynamic/Var.h"
+
+#include <optional>
+#include <string>
+
+namespace search_service {
+
+    /**
+     * @brief Сильный ETag представления сущности: SHA-1 её JSON сериализации в кавычках.
+     */
+    std::string MakeETag(const Poco::Dynamic::Var& json);
+
+    /**
+     * @brief ETag сжатого представления: "<sha1>-gzip".
+     * @details Сильный ETag не может быть общим у тел с разным Content-Encoding (RFC 7232, 2.3.3).
+     */
+    std::string WithContentCoding(const std::string& etag, const std::string& coding);
+
+    /**
+     * @brief Проверка заголовка If-None-Match.
+     * @details Для If-None-Match используется слабое сравнение (RFC 7232, 3.2):
+     * префикс W/ игнорируется, "*" совпадает с любым существующим представлением.
+     * Суффикс кодировки не учитывается: сущность та же при любом сжатии.
+     * @return ETag из запроса, с которым совпало представление, или пусто.
+     */
+    std::optional<std::string> MatchIfNoneMatch(const std::string& if_none_match, const std::string& etag);
+
+} // namespace search_service
+
+#endif //SERVER_ETAG_H
@@ -0,0 +1,633 @@
+#include "event_loop_server.h"
+
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/String.h"
+#include "Poco/Timestamp.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+    constexpr const size_t kMaxHeaderSize   = 64 * 1024;
+    constexpr const size_t kMaxBodySize     = 16 * 1024 * 1024;
+    constexpr const size_t kReadChunkSize   = 16 * 1024;
+    constexpr const int    kMaxEvents       = 256;
+    constexpr const int    kEpollTimeoutMs  = 500;
+    constexpr const Poco::Timestamp::TimeDiff kIdleCheckInterval = 1000000;
+
+    const char kListenTag = 0;
+    const char kWakeTag   = 0;
+
+    const std::string kBadRequestResponse =
+            "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    const std::string kLengthRequiredResponse =
+            "HTTP/1.1 411 Length Required\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    const std::string kTooLargeResponse =
+            "HTTP/1.1 413 Payload Too Large\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    const std::string kUnavailableResponse =
+            "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\nRetry-After: 1\r\nConnection: close\r\n\r\n";
+
+    enum class RequestBoundary {
+        Incomplete,
+        Complete,
+        Invalid,
+        LengthRequired,
+        TooLarge
+    };
+
+    /**
+     * @brief Определение границы первого запроса в буфере соединения.
+     * @param input - принятые данные
+     * @param request_size - размер запроса (заголовок + тело), если он принят целиком
+     */
+    RequestBoundary FindRequestBoundary(const std::string& input, size_t& request_size) {
+        size_t header_end = input.find("\r\n\r\n");
+        if ( header_end == std::string::npos ) {
+            return input.size() > kMaxHeaderSize ? RequestBoundary::TooLarge : RequestBoundary::Incomplete;
+        }
+        header_end += 4;
+
+        size_t content_length = 0;
+        size_t line_begin = input.find("\r\n") + 2;
+        while ( line_begin < header_end - 2 ) {
+            size_t line_end = input.find("\r\n", line_begin);
+            size_t colon = input.find(':', line_begin);
+
+            if ( colon != std::string::npos && colon < line_end ) {
+                std::string name = input.substr(line_begin, colon - line_begin);
+                std::string value = Poco::trim(input.substr(colon + 1, line_end - colon - 1));
+
+                if ( Poco::icompare(name, "Content-Length") == 0 ) {
+                    try {
+                        content_length = std::stoul(value);
+                    } catch ( const std::exception& ) {
+                        return RequestBoundary::Invalid;
+                    }
+                } else if ( Poco::icompare(name, "Transfer-Encoding") == 0 &&
+                            Poco::icompare(value, "identity") != 0 ) {
+                    return RequestBoundary::LengthRequired;
+                }
+            }
+            line_begin = line_end + 2;
+        }
+
+        if ( content_length > kMaxBodySize ) {
+            return RequestBoundary::TooLarge;
+        }
+        if ( input.size() < header_end + content_length ) {
+            return RequestBoundary::Incomplete;
+        }
+
+        request_size = header_end + content_length;
+        return RequestBoundary::Complete;
+    }
+
+    /**
+     * @brief Ответ, целиком накапливаемый в памяти и сериализуемый после обработки.
+     */
+    class BufferedServerResponse : public Poco::Net::HTTPServerResponse {
+    public:
+        BufferedServerResponse() : sent_(false) { /* Empty */ }
+
+        void sendContinue() override { /* Тело запроса уже прочитано целиком */ }
+
+        std::ostream& send() override {
+            sent_ = true;
+            return body_;
+        }
+
+        /* Заголовки и тело собираются в Serialize(), поэтому оба потока - буфер тела */
+        std::pair<std::ostream*, std::ostream*> beginSend() override {
+            sent_ = true;
+            return { &body_, &body_ };
+        }
+
+        void sendFile(const std::string& path, const std::string& media_type) override {
+            std::ifstream fin(path, std::ios::binary);
+            if ( !fin.is_open() ) {
+                throw Poco::FileNotFoundException(path);
+            }
+            setContentType(media_type);
+            body_ << fin.rdbuf();
+            sent_ = true;
+        }
+
+        void sendBuffer(const void* buffer, std::size_t length) override {
+            body_.write(static_cast<const char*>(buffer), static_cast<std::streamsize>(length));
+            sent_ = true;
+        }
+
+        void redirect(const std::string& uri, HTTPStatus status) override {
+            setStatusAndReason(status);
+            set("Location", uri);
+            sent_ = true;
+        }
+
+        void requireAuthentication(const std::string& realm) override {
+            setStatusAndReason(HTTP_UNAUTHORIZED);
+            set("WWW-Authenticate", "Basic realm=\"" + realm + "\"");
+            sent_ = true;
+        }
+
+        [[nodiscard]] bool sent() const override { return sent_; }
+
+        std::string Serialize(bool keep_alive) {
+            std::string body = body_.str();
+
+            setChunkedTransferEncoding(false);
+            setContentLength(static_cast<std::streamsize>(body.size()));
+            setKeepAlive(keep_alive);
+            if ( !has("Date") ) {
+                setDate(Poco::Timestamp());
+            }
+
+            std::ostringstream out;
+            write(out);
+            out << body;
+            return out.str();
+        }
+
+    private:
+        std::ostringstream body_;
+        bool sent_;
+    };
+
+    /**
+     * @brief Запрос, заголовок и тело которого уже прочитаны реактором.
+     */
+    class BufferedServerRequest : public Poco::Net::HTTPServerRequest {
+    public:
+        BufferedServerRequest(std::string body,
+                              const Poco::Net::SocketAddress& client_address,
+                              const Poco::Net::SocketAddress& server_address,
+                              const Poco::Net::HTTPServerParams::Ptr& params,
+                              Poco::Net::HTTPServerResponse& response) :
+            body_(std::move(body)),
+            client_address_(client_address),
+            server_address_(server_address),
+            params_(params),
+            response_(response) { /* Empty */ }
+
+        std::istream& stream() override { return body_; }
+
+        [[nodiscard]] const Poco::Net::SocketAddress& clientAddress() const override { return client_address_; }
+
+        [[nodiscard]] const Poco::Net::SocketAddress& serverAddress() const override { return server_address_; }
+
+        [[nodiscard]] const Poco::Net::HTTPServerParams& serverParams() const override { return *params_; }
+
+        [[nodiscard]] Poco::Net::HTTPServerResponse& response() const override { return response_; }
+
+        [[nodiscard]] bool secure() const override { return false; }
+
+    private:
+        std::istringstream body_;
+        Poco::Net::SocketAddress client_address_;
+        Poco::Net::SocketAddress server_address_;
+        Poco::Net::HTTPServerParams::Ptr params_;
+        Poco::Net::HTTPServerResponse& response_;
+    };
+
+} // namespace [ Functions ]
+
+namespace search_service {
+
+    struct EventLoopServer::Connection {
+        int fd{ -1 };
+        Poco::Net::SocketAddress client_address;
+        std::string input;
+        std::string output;
+        size_t output_offset{ 0 };
+        size_t request_size{ 0 };
+        bool keep_alive{ true };
+        bool processing{ false };
+        int served{ 0 };
+        Poco::Timestamp last_activity;
+    };
+
+    class EventLoopServer::Reactor {
+    public:
+        explicit Reactor(EventLoopServer& server) :
+            server_(server),
+            epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+            wake_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+
+            if ( epoll_fd_ < 0 || wake_fd_ < 0 ) {
+                throw Poco::Net::NetException("Failed to create epoll reactor");
+            }
+
+            epoll_event listen_event{};
+            listen_event.events = EPOLLIN | EPOLLEXCLUSIVE;
+            listen_event.data.ptr = const_cast<char*>(&kListenTag);
+            epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, server_.socket_.impl()->sockfd(), &listen_event);
+
+            epoll_event wake_event{};
+            wake_event.events = EPOLLIN;
+            wake_event.data.ptr = const_cast<char*>(&kWakeTag);
+            epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &wake_event);
+        }
+
+        ~Reactor() {
+            for ( auto& entry : connections_ ) {
+                ::close(entry.first);
+            }
+            ::close(wake_fd_);
+            ::close(epoll_fd_);
+        }
+
+        void Start() {
+            thread_ = std::thread([this]() { Run(); });
+        }
+
+        void Join() {
+            Wake();
+            if ( thread_.joinable() ) thread_.join();
+        }
+
+        void Wake() {
+            uint64_t one = 1;
+            [[maybe_unused]] auto written = ::write(wake_fd_, &one, sizeof(one));
+        }
+
+        /* Вызывается обработчиком после формирования ответа */
+        void Complete(Connection* connection) {
+            {
+                std::lock_guard<std::mutex> lck(completed_mtx_);
+                completed_.push_back(connection);
+            }
+            Wake();
+        }
+
+        /* Немедленный ответ без передачи в пул обработчиков, соединение закрывается после записи */
+        void Reject(Connection* connection, const std::string& response) {
+            connection->keep_alive = false;
+            connection->processing = true;
+            connection->output = response;
+            connection->output_offset = 0;
+            OnWritable(connection);
+        }
+
+    private:
+        void Run() {
+            epoll_event events[kMaxEvents];
+
+            while ( server_.running_ ) {
+                int count = epoll_wait(epoll_fd_, events, kMaxEvents, kEpollTimeoutMs);
+
+                for ( int i = 0; i < count; i++ ) {
+                    void* tag = events[i].data.ptr;
+
+                    if ( tag == &kListenTag ) {
+                        Accept();
+                    } else if ( tag == &kWakeTag ) {
+                        uint64_t value;
+                        [[maybe_unused]] auto read = ::read(wake_fd_, &value, sizeof(value));
+                        DrainCompleted();
+                    } else {
+                        auto* connection = static_cast<Connection*>(tag);
+                        if ( events[i].events & (EPOLLERR | EPOLLHUP) ) {
+                            Close(connection);
+                        } else if ( events[i].events & EPOLLOUT ) {
+                            OnWritable(connection);
+                        } else {
+                            OnReadable(connection);
+                        }
+                    }
+                }
+
+                CloseIdle();
+            }
+        }
+
+        void Accept() {
+            while ( true ) {
+                sockaddr_storage address{};
+                socklen_t length = sizeof(address);
+
+                int fd = accept4(server_.socket_.impl()->sockfd(), reinterpret_cast<sockaddr*>(&address),
+                                 &length, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if ( fd < 0 ) {
+                    return;
+                }
+
+                int no_delay = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+
+                auto connection = std::make_unique<Connection>();
+                connection->fd = fd;
+                connection->client_address = Poco::Net::SocketAddress(reinterpret_cast<sockaddr*>(&address), length);
+
+                epoll_event event{};
+                event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+                event.data.ptr = connection.get();
+                if ( epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0 ) {
+                    ::close(fd);
+                    continue;
+                }
+
+                connections_.emplace(fd, std::move(connection));
+            }
+        }
+
+        void OnReadable(Connection* connection) {
+            char buffer[kReadChunkSize];
+
+            while ( true ) {
+                ssize_t received = ::recv(connection->fd, buffer, sizeof(buffer), 0);
+                if ( received > 0 ) {
+                    connection->input.append(buffer, static_cast<size_t>(received));
+                    continue;
+                }
+                if ( received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) ) {
+                    break;
+                }
+                if ( received < 0 && errno == EINTR ) {
+                    continue;
+                }
+                Close(connection);
+                return;
+            }
+
+            connection->last_activity.update();
+            Dispatch(connection);
+        }
+
+        void OnWritable(Connection* connection) {
+            while ( connection->output_offset < connection->output.size() ) {
+                ssize_t written = ::send(connection->fd,
+                                         connection->output.data() + connection->output_offset,
+                                         connection->output.size() - connection->output_offset,
+                                         MSG_NOSIGNAL);
+                if ( written > 0 ) {
+                    connection->output_offset += static_cast<size_t>(written);
+                    continue;
+                }
+                if ( written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) ) {
+                    Rearm(connection, EPOLLOUT);
+                    return;
+                }
+                if ( written < 0 && errno == EINTR ) {
+                    continue;
+                }
+                Close(connection);
+                return;
+            }
+
+            if ( !connection->keep_alive ) {
+                Close(connection);
+                return;
+            }
+
+            connection->output.clear();
+            connection->output_offset = 0;
+            connection->processing = false;
+            connection->last_activity.update();
+
+            /* В буфере может уже находиться следующий конвейерный запрос */
+            Dispatch(connection);
+        }
+
+        void Dispatch(Connection* connection) {
+            size_t request_size = 0;
+            switch ( FindRequestBoundary(connection->input, request_size) ) {
+                case RequestBoundary::Incomplete:
+                    Rearm(connection, EPOLLIN);
+                    return;
+                case RequestBoundary::Invalid:
+                    Reject(connection, kBadRequestResponse);
+                    return;
+                case RequestBoundary::LengthRequired:
+                    Reject(connection, kLengthRequiredResponse);
+                    return;
+                case RequestBoundary::TooLarge:
+                    Reject(connection, kTooLargeResponse);
+                    return;
+                case RequestBoundary::Complete:
+                    break;
+            }
+
+            connection->request_size = request_size;
+            connection->processing = true;
+            if ( !server_.Submit(this, connection) ) {
+                Reject(connection, kUnavailableResponse);
+            }
+        }
+
+        void DrainCompleted() {
+            std::vector<Connection*> completed;
+            {
+                std::lock_guard<std::mutex> lck(completed_mtx_);
+                completed.swap(completed_);
+            }
+            for ( auto* connection : completed ) {
+                OnWritable(connection);
+            }
+        }
+
+        void Rearm(Connection* connection, uint32_t events) {
+            epoll_event event{};
+            event.events = events | EPOLLRDHUP | EPOLLONESHOT;
+            event.data.ptr = connection;
+            if ( epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection->fd, &event) < 0 ) {
+                Close(connection);
+            }
+        }
+
+        void Close(Connection* connection) {
+            int fd = connection->fd;
+            ::close(fd);
+            connections_.erase(fd);
+        }
+
+        void CloseIdle() {
+            if ( !last_idle_check_.isElapsed(kIdleCheckInterval) ) {
+                return;
+            }
+            last_idle_check_.update();
+
+            Poco::Timestamp::TimeDiff idle_limit = server_.params_->getKeepAliveTimeout().totalMicroseconds();
+            std::vector<Connection*> idle;
+            for ( auto& entry : connections_ ) {
+                auto& connection = entry.second;
+                if ( !connection->processing && connection->last_activity.isElapsed(idle_limit) ) {
+                    idle.push_back(connection.get());
+                }
+            }
+            for ( auto* connection : idle ) {
+                Close(connection);
+            }
+        }
+
+    private:
+        EventLoopServer& server_;
+        int epoll_fd_;
+        int wake_fd_;
+        std::thread thread_;
+        std::unordered_map<int, std::unique_ptr<Connection>> connections_;
+
+        std::mutex completed_mtx_;
+        std::vector<Connection*> completed_;
+
+        Poco::Timestamp last_idle_check_;
+    };
+
+} // namespace search_service
+
+namespace search_service {
+
+    EventLoopServer::EventLoopServer(Poco::Net::HTTPRequestHandlerFactory::Ptr factory,
+                                     const Poco::Net::ServerSocket& socket,
+                                     Poco::Net::HTTPServerParams::Ptr params,
+                                     unsigned int reactor_threads) :
+        factory_(std::move(factory)),
+        socket_(socket),
+        params_(std::move(params)),
+        reactor_threads_(reactor_threads == 0 ? 1 : reactor_threads),
+        running_(false),
+        queued_(0) { /* Empty */ }
+
+    EventLoopServer::~EventLoopServer() {
+        stop();
+    }
+
+    void EventLoopServer::start() {
+        if ( running_ ) return;
+
+        socket_.setBlocking(false);
+        running_ = true;
+
+        for ( unsigned int i = 0; i < reactor_threads_; i++ ) {
+            reactors_.push_back(std::make_unique<Reactor>(*this));
+        }
+
+        int workers = params_->getMaxThreads() > 0 ? params_->getMaxThreads() : 1;
+        for ( int i = 0; i < workers; i++ ) {
+            workers_.emplace_back([this]() { WorkerLoop(); });
+        }
+
+        for ( auto& reactor : reactors_ ) {
+            reactor->Start();
+        }
+
+        std::cout << "Event loop server started with " << reactor_threads_ << " reactors and "
+                  << workers << " workers." << std::endl;
+    }
+
+    void EventLoopServer::stop() {
+        if ( !running_.exchange(false) ) return;
+
+        tasks_cv_.notify_all();
+        for ( auto& worker : workers_ ) {
+            if ( worker.joinable() ) worker.join();
+        }
+        workers_.clear();
+
+        for ( auto& reactor : reactors_ ) {
+            reactor->Join();
+        }
+        reactors_.clear();
+
+        std::lock_guard<std::mutex> lck(tasks_mtx_);
+        tasks_.clear();
+        queued_ = 0;
+    }
+
+    int EventLoopServer::queuedConnections() const noexcept {
+        return queued_.load(std::memory_order_relaxed);
+    }
+
+    bool EventLoopServer::Submit(Reactor* reactor, Connection* connection) {
+        {
+            std::lock_guard<std::mutex> lck(tasks_mtx_);
+            if ( params_->getMaxQueued() > 0 && static_cast<int>(tasks_.size()) >= params_->getMaxQueued() ) {
+                return false;
+            }
+            tasks_.emplace_back(reactor, connection);
+            queued_++;
+        }
+        tasks_cv_.notify_one();
+        return true;
+    }
+
+    void EventLoopServer::WorkerLoop() {
+        while ( true ) {
+            std::pair<Reactor*, Connection*> task;
+            {
+                std::unique_lock<std::mutex> lck(tasks_mtx_);
+                tasks_cv_.wait(lck, [this]() { return !running_ || !tasks_.empty(); });
+                if ( !running_ ) return;
+
+                task = tasks_.front();
+                tasks_.pop_front();
+                queued_--;
+            }
+
+            Process(task.second);
+            task.first->Complete(task.second);
+        }
+    }
+
+    void EventLoopServer::Process(Connection* connection) {
+        std::string raw = connection->input.substr(0, connection->request_size);
+        connection->input.erase(0, connection->request_size);
+
+        size_t header_size = raw.find("\r\n\r\n") + 4;
+        std::istringstream header_stream(raw.substr(0, header_size));
+
+        BufferedServerResponse response;
+        BufferedServerRequest request(raw.substr(header_size), connection->client_address,
+                                      socket_.address(), params_, response);
+
+        try {
+            request.read(header_stream);
+        } catch ( const Poco::Exception& ) {
+            connection->keep_alive = false;
+            connection->output = kBadRequestResponse;
+            connection->output_offset = 0;
+            return;
+        }
+
+        connection->served++;
+        bool keep_alive = params_->getKeepAlive() && request.getKeepAlive() &&
+                          (params_->getMaxKeepAliveRequests() <= 0 ||
+                           connection->served < params_->getMaxKeepAliveRequests());
+
+        response.setVersion(request.getVersion());
+        response.setKeepAlive(keep_alive);
+
+        try {
+            std::unique_ptr<Poco::Net::HTTPRequestHandler> handler(factory_->createRequestHandler(request));
+            if ( handler ) {
+                handler->handleRequest(request, response);
+            } else {
+                response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_NOT_IMPLEMENTED);
+            }
+        } catch ( const std::exception& e ) {
+            std::cerr << "Event loop handler exception: " << e.what() << std::endl;
+            if ( !response.sent() ) {
+                response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+            }
+            keep_alive = false;
+        }
+
+        connection->keep_alive = keep_alive;
+        connection->output = response.Serialize(keep_alive);
+        connection->output_offset = 0;
+    }
+
+} // namespace search_service
@@ -0,0 +1,70 @@
+#ifndef SERVER_EVENT_LOOP_SERVER_H
+#define SERVER_EVENT_LOOP_SERVER_H
+
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/ServerSocket.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace search_service {
+
+    /**
+     * @brief HTTP сервер на основе epoll.
+     * @details Небольшое число потоков-реакторов принимает соединения и читает запросы
+     * без блокировки, а готовые запросы передаются в пул обработчиков, где вызываются
+     * обычные обработчики из HTTPRequestHandlerFactory. Простаивающее keep-alive
+     * соединение занимает только буферы, а не поток.
+     */
+    class EventLoopServer {
+    public:
+        EventLoopServer(Poco::Net::HTTPRequestHandlerFactory::Ptr factory,
+                        const Poco::Net::ServerSocket& socket,
+                        Poco::Net::HTTPServerParams::Ptr params,
+                        unsigned int reactor_threads);
+
+        ~EventLoopServer();
+
+        EventLoopServer(const EventLoopServer&) = delete;
+        EventLoopServer& operator=(const EventLoopServer&) = delete;
+
+        void start();
+        void stop();
+
+        /* Число запросов, ожидающих свободного обработчика */
+        [[nodiscard]] int queuedConnections() const noexcept;
+
+    private:
+        struct Connection;
+        class Reactor;
+
+        bool Submit(Reactor* reactor, Connection* connection);
+        void WorkerLoop();
+        void Process(Connection* connection);
+
+    private:
+        Poco::Net::HTTPRequestHandlerFactory::Ptr factory_;
+        Poco::Net::ServerSocket socket_;
+        Poco::Net::HTTPServerParams::Ptr params_;
+        unsigned int reactor_threads_;
+
+        std::vector<std::unique_ptr<Reactor>> reactors_;
+        std::vector<std::thread> workers_;
+
+        std::mutex tasks_mtx_;
+        std::condition_variable tasks_cv_;
+        std::deque<std::pair<Reactor*, Connection*>> tasks_;
+
+        std::atomic<bool> running_;
+        std::atomic<int> queued_;
+    };
+
+} // namespace search_service
+
+#endif //SERVER_EVENT_LOOP_SERVER_H
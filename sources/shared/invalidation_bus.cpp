@@ -0,0 +1,210 @@
+#include "invalidation_bus.h"
+
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <redis-cpp/stream.h>
+#include <redis-cpp/execute.h>
+
+namespace {
+
+    constexpr const auto kReconnectDelay = std::chrono::seconds(1);
+
+    /* Сообщение, которым Stop() будит поток подписчика */
+    constexpr const char* const kStopMessage = "stop";
+
+} // namespace [ Constants ]
+
+namespace {
+
+    bool ReadLine(std::istream& stream, std::string& line) {
+        if ( !std::getline(stream, line) ) return false;
+        if ( !line.empty() && line.back() == '\r' ) line.pop_back();
+        return !line.empty();
+    }
+
+    /**
+     * @brief Чтение одного ответа RESP в виде плоского списка строк.
+     * @details В режиме подписки сервер присылает только массивы из bulk-строк и чисел,
+     * поэтому вложенные массивы не разбираются.
+     */
+    std::optional<std::vector<std::string>> ReadReply(std::istream& stream) {
+        std::string line;
+        if ( !ReadLine(stream, line) ) return std::nullopt;
+
+        if ( line.front() != '*' ) {
+            return std::vector<std::string>{ line.substr(1) };
+        }
+
+        long count = std::stol(line.substr(1));
+        std::vector<std::string> items;
+        items.reserve(count > 0 ? static_cast<size_t>(count) : 0);
+
+        for ( long i = 0; i < count; i++ ) {
+            if ( !ReadLine(stream, line) ) return std::nullopt;
+
+            if ( line.front() != '$' ) {
+                items.push_back(line.substr(1));
+                continue;
+            }
+
+            long length = std::stol(line.substr(1));
+            if ( length < 0 ) {
+                items.emplace_back();
+                continue;
+            }
+
+            std::string item(static_cast<size_t>(length), '\0');
+            stream.read(item.data(), length);
+            stream.ignore(2);
+            if ( !stream ) return std::nullopt;
+            items.push_back(std::move(item));
+        }
+        return items;
+    }
+
+} // namespace [ Functions ]
+
+namespace search_service
+{
+    InvalidationBus::InvalidationBus() : _running(false) {}
+
+    InvalidationBus* InvalidationBus::Get() {
+        static InvalidationBus* instance;
+        if ( !instance ) instance = new InvalidationBus();
+        return instance;
+    }
+
+    void InvalidationBus::Start(const std::string& server_ip, unsigned int port, const std::string& channel,
+                                OnInvalidate on_invalidate, OnResubscribe on_resubscribe) {
+        if ( _running.exchange(true) ) return;
+
+        std::cout << "invalidation bus host:" << server_ip << " port:" << port << " channel:" << channel << std::endl;
+        _host = server_ip;
+        _port = std::to_string(port);
+        _channel = channel;
+        _on_invalidate = std::move(on_invalidate);
+        _on_resubscribe = std::move(on_resubscribe);
+
+        {
+            std::lock_guard<std::mutex> lck(_publish_mtx);
+            _publish_stream = Connect();
+        }
+        _listener = std::thread(&InvalidationBus::Listen, this);
+    }
+
+    void InvalidationBus::Stop() {
+        if ( !_running.exchange(false) ) return;
+
+        {
+            std::lock_guard<std::mutex> lck(_publish_mtx);
+            try {
+                if ( _publish_stream && _publish_stream->good() ) {
+                    rediscpp::value response = rediscpp::execute(*_publish_stream, "publish", _channel, kStopMessage);
+                }
+            } catch ( const std::exception& e ) {
+                std::cerr << "Invalidation bus stop error: " << e.what() << std::endl;
+            }
+        }
+
+        if ( _listener.joinable() ) _listener.join();
+    }
+
+    void InvalidationBus::Publish(long id) {
+        if ( !_running ) return;
+
+        std::lock_guard<std::mutex> lck(_publish_mtx);
+        try {
+            if ( !_publish_stream || !_publish_stream->good() ) {
+                _publish_stream = Connect();
+            }
+            if ( !_publish_stream || !_publish_stream->good() ) throw std::runtime_error("bus is unavailable");
+
+            rediscpp::value response = rediscpp::execute(*_publish_stream, "publish", _channel, std::to_string(id));
+        } catch ( const std::exception& e ) {
+            std::cerr << "Invalidation bus publish error: " << e.what() << std::endl;
+            if ( _publish_stream ) _publish_stream->setstate(std::ios::badbit);
+        }
+    }
+
+    void InvalidationBus::Listen() {
+        while ( _running ) {
+            Stream stream = Connect();
+            if ( !stream || !Subscribe(stream) ) {
+                std::this_thread::sleep_for(kReconnectDelay);
+                continue;
+            }
+
+            /* Всё, что было опубликовано до подписки, могло быть пропущено */
+            bool restored = false;
+            try {
+                restored = _on_resubscribe();
+            } catch ( const std::exception& e ) {
+                std::cerr << "Invalidation bus resubscribe error: " << e.what() << std::endl;
+            }
+            if ( !restored ) {
+                std::this_thread::sleep_for(kReconnectDelay);
+                continue;
+            }
+
+            while ( _running ) {
+                std::optional<std::vector<std::string>> reply;
+                try {
+                    reply = ReadReply(*stream);
+                } catch ( const std::exception& e ) {
+                    std::cerr << "Invalidation bus read error: " << e.what() << std::endl;
+                }
+                if ( !reply.has_value() ) break;
+
+                /* message <channel> <payload> */
+                const auto& items = *reply;
+                if ( items.size() != 3 || items[0] != "message" ) continue;
+
+                long id;
+                try {
+                    id = std::stol(items[2]);
+                } catch ( const std::exception& ) {
+                    /* Служебное сообщение, например kStopMessage */
+                    continue;
+                }
+
+                try {
+                    _on_invalidate(id);
+                } catch ( const std::exception& e ) {
+                    std::cerr << "Invalidation bus handler error: " << e.what() << std::endl;
+                }
+            }
+        }
+    }
+
+    bool InvalidationBus::Subscribe(Stream& stream) const {
+        try {
+            *stream << "*2\r\n$9\r\nsubscribe\r\n$" << _channel.size() << "\r\n" << _channel << "\r\n";
+            stream->flush();
+
+            auto reply = ReadReply(*stream);
+            return reply.has_value() && !reply->empty() && reply->front() == "subscribe";
+        } catch ( const std::exception& e ) {
+            std::cerr << "Invalidation bus subscribe error: " << e.what() << std::endl;
+        }
+        return false;
+    }
+
+    InvalidationBus::Stream InvalidationBus::Connect() const {
+        try {
+            Stream stream = rediscpp::make_stream(_host, _port);
+            if ( !stream->good() ) {
+                std::cerr << "Error opening invalidation bus stream." << std::endl;
+                return nullptr;
+            }
+            return stream;
+        } catch ( const std::exception& e ) {
+            std::cerr << "Error opening invalidation bus stream: " << e.what() << std::endl;
+        }
+        return nullptr;
+    }
+
+} // namespace search_service
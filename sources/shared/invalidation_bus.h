@@ -0,0 +1,62 @@
+#ifndef SERVER_INVALIDATION_BUS_H
+#define SERVER_INVALIDATION_BUS_H
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace search_service
+{
+    /**
+     * @brief Рассылка инвалидаций между экземплярами сервиса через Redis pub/sub.
+     * @details Каждый экземпляр подписан на канал и по сообщению с id вызывает on_invalidate.
+     * Пока подписка разорвана, сообщения теряются, поэтому после каждой подписки вызывается
+     * on_resubscribe, который сбрасывает или перечитывает всё, что могло устареть.
+     */
+    class InvalidationBus
+    {
+        InvalidationBus();
+
+    public:
+        static InvalidationBus* Get();
+
+        /* Вызывается потоком подписчика */
+        using OnInvalidate = std::function<void(long id)>;
+        /* false - состояние не восстановлено, подписка будет повторена */
+        using OnResubscribe = std::function<bool()>;
+
+        void Start(const std::string& server_ip, unsigned int port, const std::string& channel,
+                   OnInvalidate on_invalidate, OnResubscribe on_resubscribe);
+        void Stop();
+
+        void Publish(long id);
+
+    private:
+        using Stream = std::shared_ptr<std::iostream>;
+
+        void Listen();
+        bool Subscribe(Stream& stream) const;
+        Stream Connect() const;
+
+    private:
+        std::string _host;
+        std::string _port;
+        std::string _channel;
+        OnInvalidate _on_invalidate;
+        OnResubscribe _on_resubscribe;
+
+        std::atomic<bool> _running;
+        std::thread _listener;
+
+        std::mutex _publish_mtx;
+        Stream _publish_stream;
+    };
+
+} // namespace search_service
+
+
+#endif //SERVER_INVALIDATION_BUS_H
@@ -0,0 +1,61 @@
+#include "read_your_writes.h"
+
+#include <Poco/Net/HTTPCookie.h>
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/Net/NameValueCollection.h>
+#include <Poco/NumberParser.h>
+#include <Poco/Timestamp.h>
+
+#include <string>
+
+namespace {
+
+    /* Время последней записи клиента текущего запроса, 0 - клиент не писал */
+    thread_local int64_t current_written_at = 0;
+    thread_local Poco::Net::HTTPServerResponse* current_response = nullptr;
+    thread_local bool current_cookie_set = false;
+
+} // namespace [ Variables ]
+
+namespace search_service {
+
+    bool ReadYourWrites::Pinned(int64_t window_us) noexcept {
+        if ( current_written_at == 0 || window_us <= 0 ) return false;
+        return current_written_at + window_us > Poco::Timestamp().epochMicroseconds();
+    }
+
+    void ReadYourWrites::NoteWrite() {
+        current_written_at = Poco::Timestamp().epochMicroseconds();
+
+        /* Записи идут до отправки ответа, повторные записи запроса cookie не дублируют */
+        if ( !current_response || current_cookie_set ) return;
+
+        Poco::Net::HTTPCookie cookie(kLastWriteCookie, std::to_string(current_written_at));
+        cookie.setPath("/");
+        cookie.setHttpOnly(true);
+        current_response->addCookie(cookie);
+        current_cookie_set = true;
+    }
+
+    ReadYourWrites::Scope::Scope(const Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response) :
+        previous_written_at_(current_written_at),
+        previous_response_(current_response),
+        previous_cookie_set_(current_cookie_set) {
+
+        Poco::Net::NameValueCollection cookies;
+        request.getCookies(cookies);
+
+        Poco::Int64 written_at = 0;
+        current_written_at = Poco::NumberParser::tryParse64(cookies.get(kLastWriteCookie, ""), written_at) ? written_at : 0;
+        current_response = &response;
+        current_cookie_set = false;
+    }
+
+    ReadYourWrites::Scope::~Scope() {
+        current_written_at = previous_written_at_;
+        current_response = previous_response_;
+        current_cookie_set = previous_cookie_set_;
+    }
+
+} // namespace search_service
@@ -0,0 +1,48 @@
+#ifndef SERVER_READ_YOUR_WRITES_H
+#define SERVER_READ_YOUR_WRITES_H
+
+#include <cstdint>
+
+namespace Poco::Net {
+    class HTTPServerRequest;
+    class HTTPServerResponse;
+} // namespace Poco::Net
+
+namespace search_service {
+
+    /* Время последней записи клиента в микросекундах от эпохи, клиент возвращает его в следующих запросах */
+    constexpr const char* const kLastWriteCookie = "last_write_us";
+
+    /**
+     * @brief Чтение своих записей в пределах клиента, а не всего процесса.
+     * @details Запрос, изменивший данные, ставит клиенту cookie со временем записи.
+     * Пока с этого времени не прошло окно read-your-writes, чтения этого клиента
+     * идут на основной сервер на любом экземпляре сервиса, остальные клиенты
+     * продолжают читать с реплик. Состояние хранится в потоке запроса на время Scope.
+     */
+    class ReadYourWrites {
+    public:
+        /* Клиент текущего запроса писал не раньше window_us назад */
+        [[nodiscard]] static bool Pinned(int64_t window_us) noexcept;
+
+        /* Запись в текущем запросе: ответ получает cookie, дальнейшие чтения запроса идут на основной сервер */
+        static void NoteWrite();
+
+        class Scope {
+        public:
+            Scope(const Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            int64_t previous_written_at_;
+            Poco::Net::HTTPServerResponse* previous_response_;
+            bool previous_cookie_set_;
+        };
+    };
+
+} // namespace search_service
+
+#endif //SERVER_READ_YOUR_WRITES_H
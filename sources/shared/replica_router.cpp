@@ -0,0 +1,182 @@
+#include "replica_router.h"
+#include "read_your_writes.h"
+
+#include <Poco/Data/DataException.h>
+#include <Poco/Data/MySQL/Connector.h>
+#include <Poco/Data/MySQL/MySQLException.h>
+#include <Poco/Data/RecordSet.h>
+#include <Poco/Data/Statement.h>
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+
+    /* Запросы состояния репликации для MySQL 8.0.22+ и для более ранних версий */
+    constexpr const char* const kReplicaStatusRequests[] = { "SHOW REPLICA STATUS", "SHOW SLAVE STATUS" };
+    constexpr const char* const kLagColumns[] = { "Seconds_Behind_Source", "Seconds_Behind_Master" };
+
+} // namespace [ Constants ]
+
+namespace {
+
+    /**
+     * @brief Отставание реплики в секундах.
+     * @return Пусто, если репликация не настроена или остановлена.
+     */
+    std::optional<long> ReadReplicationLag(Poco::Data::Session& session) {
+        for ( const char* request : kReplicaStatusRequests ) {
+            try {
+                Poco::Data::Statement status(session);
+                status << request;
+                status.execute();
+
+                Poco::Data::RecordSet result(status);
+                if ( result.rowCount() == 0 ) {
+                    return std::nullopt;
+                }
+
+                for ( std::size_t column = 0; column < result.columnCount(); column++ ) {
+                    for ( const char* lag_column : kLagColumns ) {
+                        if ( result.columnName(column) != lag_column ) continue;
+
+                        Poco::Dynamic::Var lag = result.value(column, 0);
+                        if ( lag.isEmpty() ) return std::nullopt;
+                        return lag.convert<long>();
+                    }
+                }
+                return std::nullopt;
+            } catch ( const Poco::Data::MySQL::StatementException& ) {
+                continue;
+            }
+        }
+        return std::nullopt;
+    }
+
+} // namespace [ Functions ]
+
+namespace search_service {
+
+    struct ReplicaRouter::Replica {
+        std::unique_ptr<Poco::Data::SessionPool> pool;
+        std::atomic<bool> eligible{ false };
+        std::atomic<long> lag{ -1 };
+    };
+
+    ReplicaRouter::ReplicaRouter(std::vector<ReplicaEndpoint> replicas,
+                                 unsigned int max_lag_sec,
+                                 unsigned int read_your_writes_window_ms) :
+        endpoints_(std::move(replicas)),
+        max_lag_sec_(max_lag_sec),
+        read_your_writes_window_us_(static_cast<int64_t>(read_your_writes_window_ms) * 1000),
+        next_(0),
+        stopping_(false) {
+
+        for ( size_t i = 0; i < endpoints_.size(); i++ ) {
+            replicas_.push_back(std::make_unique<Replica>());
+        }
+    }
+
+    ReplicaRouter::~ReplicaRouter() {
+        Stop();
+    }
+
+    void ReplicaRouter::Connect(const ConnectionStringBuilder& builder, int min_sessions, int max_sessions, int idle_time) {
+        for ( size_t i = 0; i < endpoints_.size(); i++ ) {
+            const ReplicaEndpoint& endpoint = endpoints_[i];
+            std::cout << "Read replica for shard " << endpoint.shard_id << ": "
+                      << endpoint.host << ":" << endpoint.port << std::endl;
+
+            replicas_[i]->pool = std::make_unique<Poco::Data::SessionPool>(
+                    Poco::Data::MySQL::Connector::KEY, builder(endpoint.host, endpoint.port),
+                    min_sessions, max_sessions, idle_time);
+            CheckLag(*replicas_[i]);
+        }
+    }
+
+    void ReplicaRouter::Start(unsigned int check_interval_ms) {
+        if ( replicas_.empty() || monitor_.joinable() ) return;
+
+        stopping_ = false;
+        monitor_ = std::thread([this, check_interval_ms]() { MonitorLoop(check_interval_ms); });
+    }
+
+    void ReplicaRouter::Stop() {
+        {
+            std::lock_guard<std::mutex> lck(monitor_mtx_);
+            stopping_ = true;
+        }
+        monitor_cv_.notify_all();
+
+        if ( monitor_.joinable() ) {
+            monitor_.join();
+        }
+    }
+
+    std::optional<size_t> ReplicaRouter::Pick(long shard_id) {
+        if ( replicas_.empty() ) return std::nullopt;
+
+        if ( ReadYourWrites::Pinned(read_your_writes_window_us_) ) return std::nullopt;
+
+        size_t shard = static_cast<size_t>(shard_id < 0 ? 0 : shard_id);
+
+        size_t start = next_.fetch_add(1, std::memory_order_relaxed);
+        for ( size_t i = 0; i < replicas_.size(); i++ ) {
+            size_t index = (start + i) % replicas_.size();
+            if ( endpoints_[index].shard_id == static_cast<long>(shard) &&
+                 replicas_[index]->eligible.load(std::memory_order_relaxed) ) {
+                return index;
+            }
+        }
+        return std::nullopt;
+    }
+
+    Poco::Data::SessionPool& ReplicaRouter::Pool(size_t index) {
+        return *replicas_.at(index)->pool;
+    }
+
+    void ReplicaRouter::NoteWrite() {
+        ReadYourWrites::NoteWrite();
+    }
+
+    void ReplicaRouter::MarkFailed(size_t index) noexcept {
+        if ( index < replicas_.size() ) {
+            replicas_[index]->eligible.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    const std::vector<ReplicaEndpoint>& ReplicaRouter::Endpoints() const noexcept {
+        return endpoints_;
+    }
+
+    void ReplicaRouter::MonitorLoop(unsigned int check_interval_ms) {
+        std::unique_lock<std::mutex> lck(monitor_mtx_);
+        while ( !monitor_cv_.wait_for(lck, std::chrono::milliseconds(check_interval_ms), [this]() { return stopping_; }) ) {
+            lck.unlock();
+            for ( auto& replica : replicas_ ) {
+                CheckLag(*replica);
+            }
+            lck.lock();
+        }
+    }
+
+    void ReplicaRouter::CheckLag(Replica& replica) {
+        std::optional<long> lag;
+        try {
+            Poco::Data::Session session(replica.pool->get());
+            lag = ReadReplicationLag(session);
+        } catch ( const Poco::Exception& e ) {
+            std::cout << "Replica check failed: " << e.displayText() << std::endl;
+        }
+
+        bool eligible = lag.has_value() && *lag <= static_cast<long>(max_lag_sec_);
+        if ( eligible != replica.eligible.load(std::memory_order_relaxed) ) {
+            std::cout << "Replica is " << (eligible ? "back in" : "out of") << " read rotation, lag: "
+                      << (lag.has_value() ? std::to_string(*lag) + " s" : std::string("unknown")) << std::endl;
+        }
+
+        replica.lag.store(lag.value_or(-1), std::memory_order_relaxed);
+        replica.eligible.store(eligible, std::memory_order_relaxed);
+    }
+
+} // namespace search_service
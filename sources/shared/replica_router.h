@@ -0,0 +1,81 @@
+#ifndef SERVER_REPLICA_ROUTER_H
+#define SERVER_REPLICA_ROUTER_H
+
+#include <Poco/Data/SessionPool.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace search_service {
+
+    /* Адрес реплики для чтения. Для сервисов без шардирования shard_id равен 0. */
+    struct ReplicaEndpoint {
+        std::string host;
+        unsigned int port;
+        long shard_id;
+    };
+
+    /**
+     * @brief Маршрутизация читающих запросов на реплики.
+     * @details Фоновый поток периодически запрашивает отставание каждой реплики
+     * (SHOW REPLICA STATUS). Реплика выбирается по кругу среди доступных реплик шарда
+     * с отставанием не больше max_lag. Чтения клиента, писавшего в течение окна
+     * read-your-writes, идут на основной сервер, чтобы он увидел свою запись (ReadYourWrites).
+     */
+    class ReplicaRouter {
+    public:
+        using ConnectionStringBuilder = std::function<std::string(const std::string& host, unsigned int port)>;
+
+        ReplicaRouter(std::vector<ReplicaEndpoint> replicas,
+                      unsigned int max_lag_sec,
+                      unsigned int read_your_writes_window_ms);
+
+        ~ReplicaRouter();
+
+        ReplicaRouter(const ReplicaRouter&) = delete;
+        ReplicaRouter& operator=(const ReplicaRouter&) = delete;
+
+        void Connect(const ConnectionStringBuilder& builder, int min_sessions, int max_sessions, int idle_time);
+        void Start(unsigned int check_interval_ms);
+        void Stop();
+
+        /* Индекс реплики для чтения из шарда или пусто, если читать нужно с основного сервера */
+        [[nodiscard]] std::optional<size_t> Pick(long shard_id);
+
+        Poco::Data::SessionPool& Pool(size_t index);
+
+        /* Запись текущего запроса, см. ReadYourWrites::NoteWrite() */
+        void NoteWrite();
+        void MarkFailed(size_t index) noexcept;
+
+        [[nodiscard]] const std::vector<ReplicaEndpoint>& Endpoints() const noexcept;
+
+    private:
+        struct Replica;
+
+        void MonitorLoop(unsigned int check_interval_ms);
+        void CheckLag(Replica& replica);
+
+    private:
+        std::vector<ReplicaEndpoint> endpoints_;
+        std::vector<std::unique_ptr<Replica>> replicas_;
+        unsigned int max_lag_sec_;
+        int64_t read_your_writes_window_us_;
+        std::atomic<size_t> next_;
+
+        std::thread monitor_;
+        std::mutex monitor_mtx_;
+        std::condition_variable monitor_cv_;
+        bool stopping_;
+    };
+
+} // namespace search_service
+
+#endif //SERVER_REPLICA_ROUTER_H
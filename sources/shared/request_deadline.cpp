@@ -0,0 +1,93 @@
+#include "request_deadline.h"
+#include "errors.h"
+
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/NumberParser.h>
+
+#include <algorithm>
+
+namespace {
+
+    thread_local std::optional<search_service::RequestDeadline::TimePoint> current_deadline;
+
+} // namespace [ Variables ]
+
+namespace search_service {
+
+    RequestDeadline::RequestDeadline() : timeout_ms_(0) { /* Empty */ }
+
+    RequestDeadline& RequestDeadline::Instance() {
+        static RequestDeadline instance;
+        return instance;
+    }
+
+    void RequestDeadline::Configure(unsigned int timeout_ms) {
+        timeout_ms_ = timeout_ms;
+    }
+
+    std::optional<RequestDeadline::TimePoint> RequestDeadline::Start() const {
+        unsigned int timeout_ms = timeout_ms_;
+        if ( timeout_ms == 0 ) return { };
+        return Clock::now() + std::chrono::milliseconds(timeout_ms);
+    }
+
+    std::optional<RequestDeadline::TimePoint> RequestDeadline::Current() noexcept {
+        return current_deadline;
+    }
+
+    std::optional<RequestDeadline::TimePoint> RequestDeadline::Within(unsigned int timeout_ms) noexcept {
+        if ( timeout_ms == 0 ) return current_deadline;
+
+        TimePoint limit = Clock::now() + std::chrono::milliseconds(timeout_ms);
+        if ( !current_deadline ) return limit;
+        return std::min(*current_deadline, limit);
+    }
+
+    bool RequestDeadline::Expired() noexcept {
+        return current_deadline && Clock::now() >= *current_deadline;
+    }
+
+    std::optional<unsigned int> RequestDeadline::Remaining() noexcept {
+        if ( !current_deadline ) return { };
+
+        auto now = Clock::now();
+        if ( now >= *current_deadline ) return 0u;
+        return static_cast<unsigned int>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(*current_deadline - now).count());
+    }
+
+    void RequestDeadline::Check(const std::string& what) {
+        if ( Expired() ) {
+            throw exceptions::DeadlineExceeded("Request deadline exceeded before " + what);
+        }
+    }
+
+    std::optional<RequestDeadline::TimePoint> RequestDeadline::Accept(const Poco::Net::HTTPRequest& request) const {
+        std::optional<TimePoint> deadline = Start();
+
+        unsigned int caller_ms = 0;
+        if ( !request.has(kRequestTimeoutHeader) ||
+             !Poco::NumberParser::tryParseUnsigned(request.get(kRequestTimeoutHeader), caller_ms) ) {
+            return deadline;
+        }
+
+        TimePoint caller = Clock::now() + std::chrono::milliseconds(caller_ms);
+        if ( !deadline ) return caller;
+        return std::min(*deadline, caller);
+    }
+
+    void RequestDeadline::Propagate(Poco::Net::HTTPRequest& request) {
+        if ( auto remaining = Remaining() ) {
+            request.set(kRequestTimeoutHeader, std::to_string(*remaining));
+        }
+    }
+
+    RequestDeadline::Scope::Scope(std::optional<TimePoint> deadline) noexcept : previous_(current_deadline) {
+        current_deadline = deadline;
+    }
+
+    RequestDeadline::Scope::~Scope() {
+        current_deadline = previous_;
+    }
+
+} // namespace search_service
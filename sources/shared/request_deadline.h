@@ -0,0 +1,80 @@
+#ifndef SERVER_REQUEST_DEADLINE_H
+#define SERVER_REQUEST_DEADLINE_H
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <string>
+
+namespace Poco::Net {
+    class HTTPRequest;
+} // namespace Poco::Net
+
+namespace search_service {
+
+    /* Остаток бюджета вызывающей стороны в миллисекундах, передаётся в запросах между сервисами */
+    constexpr const char* const kRequestTimeoutHeader = "X-Request-Timeout-Ms";
+
+    /**
+     * @brief Срок, к которому должен быть готов ответ на текущий запрос.
+     * @details Срок хранится в потоке, обрабатывающем запрос, на время жизни Scope.
+     * Запросы к БД и соседним сервисам берут его через Current()/Within() и
+     * прерываются, не дожидаясь ответа, который клиенту уже не нужен.
+     */
+    class RequestDeadline {
+        RequestDeadline();
+
+    public:
+        using Clock = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+
+        static RequestDeadline& Instance();
+
+        /* Бюджет времени на запрос. 0 - срок не ограничен */
+        void Configure(unsigned int timeout_ms);
+
+        /* Срок запроса, начатого сейчас, по бюджету из конфигурации */
+        [[nodiscard]] std::optional<TimePoint> Start() const;
+
+        /* Срок запроса, обрабатываемого текущим потоком */
+        [[nodiscard]] static std::optional<TimePoint> Current() noexcept;
+
+        /* Ближайший из срока запроса и now + timeout_ms. 0 - только срок запроса */
+        [[nodiscard]] static std::optional<TimePoint> Within(unsigned int timeout_ms) noexcept;
+
+        [[nodiscard]] static bool Expired() noexcept;
+
+        /* Миллисекунды до срока текущего запроса, пусто - срок не ограничен */
+        [[nodiscard]] static std::optional<unsigned int> Remaining() noexcept;
+
+        /* Исключение DeadlineExceeded, если срок истёк до начала операции what */
+        static void Check(const std::string& what);
+
+        /* Срок по заголовку входящего запроса: ближайший из Start() и остатка бюджета вызывающего */
+        [[nodiscard]] std::optional<TimePoint> Accept(const Poco::Net::HTTPRequest& request) const;
+
+        /* Передача остатка бюджета в запрос к соседнему сервису */
+        static void Propagate(Poco::Net::HTTPRequest& request);
+
+        /**
+         * @brief Установка срока текущему потоку, прежний срок восстанавливается при выходе.
+         */
+        class Scope {
+        public:
+            explicit Scope(std::optional<TimePoint> deadline) noexcept;
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            std::optional<TimePoint> previous_;
+        };
+
+    private:
+        std::atomic<unsigned int> timeout_ms_;
+    };
+
+} // namespace search_service
+
+#endif //SERVER_REQUEST_DEADLINE_H
@@ -0,0 +1,125 @@
+#include "response_compression.h"
+
+#include "etag.h"
+
+#include "Poco/DeflatingStream.h"
+#include "Poco/NumberParser.h"
+#include "Poco/String.h"
+#include "Poco/StringTokenizer.h"
+
+#include <algorithm>
+
+namespace {
+
+    constexpr const unsigned int kDefaultMinSize = 1024;
+    constexpr const int          kDefaultLevel = 6;
+    constexpr const int          kMinLevel = 1;
+    constexpr const int          kMaxLevel = 9;
+
+    constexpr const char* const kGzip = "gzip";
+    constexpr const char* const kDeflate = "deflate";
+
+} // namespace [ Constants ]
+
+namespace {
+
+    /**
+     * @brief Вес кодировки из элемента Accept-Encoding вида "gzip;q=0.8".
+     */
+    double ReadQuality(const Poco::StringTokenizer& params) {
+        for ( size_t i = 1; i < params.count(); i++ ) {
+            const std::string& param = params[i];
+            if ( param.size() > 2 && Poco::icompare(param.substr(0, 2), "q=") == 0 ) {
+                double quality = 0.0;
+                return Poco::NumberParser::tryParseFloat(param.substr(2), quality) ? quality : 0.0;
+            }
+        }
+        return 1.0;
+    }
+
+} // namespace [ Functions ]
+
+namespace search_service {
+
+    ResponseCompression::ResponseCompression() :
+        enabled_(true),
+        min_size_(kDefaultMinSize),
+        level_(kDefaultLevel) { /* Empty */ }
+
+    ResponseCompression& ResponseCompression::Instance() {
+        static ResponseCompression instance;
+        return instance;
+    }
+
+    void ResponseCompression::Configure(bool enabled, unsigned int min_size, int level) {
+        enabled_ = enabled;
+        min_size_ = min_size;
+        level_ = std::clamp(level, kMinLevel, kMaxLevel);
+    }
+
+    std::optional<ResponseCompression::Encoding> ResponseCompression::Negotiate(const std::string& accept_encoding) {
+        std::optional<double> gzip_quality;
+        std::optional<double> deflate_quality;
+        double any_quality = 0.0;
+
+        Poco::StringTokenizer codings(accept_encoding, ",",
+                                      Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+        for ( const auto& coding : codings ) {
+            Poco::StringTokenizer params(coding, ";",
+                                         Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY);
+            if ( params.count() == 0 ) continue;
+
+            double quality = ReadQuality(params);
+            if ( Poco::icompare(params[0], kGzip) == 0 || Poco::icompare(params[0], "x-gzip") == 0 ) {
+                gzip_quality = quality;
+            } else if ( Poco::icompare(params[0], kDeflate) == 0 ) {
+                deflate_quality = quality;
+            } else if ( params[0] == "*" ) {
+                any_quality = quality;
+            }
+        }
+
+        /* "*" относится только к кодировкам, не названным явно */
+        double gzip = gzip_quality.value_or(any_quality);
+        double deflate = deflate_quality.value_or(any_quality);
+
+        if ( gzip > 0.0 && gzip >= deflate ) return Encoding::Gzip;
+        if ( deflate > 0.0 ) return Encoding::Deflate;
+        return std::nullopt;
+    }
+
+    void ResponseCompression::Send(Poco::Net::HTTPServerRequest& request,
+                                   Poco::Net::HTTPServerResponse& response,
+                                   const std::string& body) {
+        response.set("Vary", "Accept-Encoding");
+
+        std::optional<Encoding> encoding;
+        if ( enabled_ && body.size() >= min_size_ && request.has("Accept-Encoding") ) {
+            encoding = Negotiate(request.get("Accept-Encoding"));
+        }
+
+        if ( !encoding.has_value() ) {
+            response.setChunkedTransferEncoding(false);
+            response.setContentLength(static_cast<std::streamsize>(body.size()));
+            response.send().write(body.data(), static_cast<std::streamsize>(body.size()));
+            return;
+        }
+
+        /* Размер сжатого тела заранее неизвестен */
+        const char* coding = *encoding == Encoding::Gzip ? kGzip : kDeflate;
+        response.setChunkedTransferEncoding(true);
+        response.set("Content-Encoding", coding);
+        if ( response.has("ETag") ) {
+            response.set("ETag", WithContentCoding(response.get("ETag"), coding));
+        }
+
+        std::ostream& ostr = response.send();
+        Poco::DeflatingOutputStream deflater(ostr,
+                                             *encoding == Encoding::Gzip ? Poco::DeflatingStreamBuf::STREAM_GZIP
+                                                                         : Poco::DeflatingStreamBuf::STREAM_ZLIB,
+                                             level_);
+        deflater.write(body.data(), static_cast<std::streamsize>(body.size()));
+        deflater.close();
+    }
+
+} // namespace search_service
@@ -0,0 +1,46 @@
+#ifndef SERVER_RESPONSE_COMPRESSION_H
+#define SERVER_RESPONSE_COMPRESSION_H
+
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+
+#include <atomic>
+#include <optional>
+#include <string>
+
+namespace search_service {
+
+    /**
+     * @brief Сжатие тела ответа по заголовку Accept-Encoding (gzip, deflate).
+     * @details Тело короче порога отправляется как есть: на малых ответах заголовки
+     * и служебные данные сжатия съедают выигрыш. Сжатие потоковое - данные проходят
+     * через zlib прямо в сокет по частям без промежуточного буфера под сжатый ответ.
+     */
+    class ResponseCompression {
+        ResponseCompression();
+
+    public:
+        enum class Encoding {
+            Gzip,
+            Deflate
+        };
+
+        static ResponseCompression& Instance();
+
+        void Configure(bool enabled, unsigned int min_size, int level);
+
+        /* Кодировка, которую принимает клиент, или пусто, если сжимать нельзя */
+        [[nodiscard]] static std::optional<Encoding> Negotiate(const std::string& accept_encoding);
+
+        /* Отправка тела ответа. Статус и Content-Type должны быть уже выставлены. */
+        void Send(Poco::Net::HTTPServerRequest& request, Poco::Net::HTTPServerResponse& response, const std::string& body);
+
+    private:
+        std::atomic<bool> enabled_;
+        std::atomic<unsigned int> min_size_;
+        std::atomic<int> level_;
+    };
+
+} // namespace search_service
+
+#endif //SERVER_RESPONSE_COMPRESSION_H
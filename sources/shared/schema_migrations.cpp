@@ -0,0 +1,136 @@
+#include "schema_migrations.h"
+
+#include <Poco/Data/MySQL/MySQLException.h>
+#include <Poco/Data/Statement.h>
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+using namespace Poco::Data::Keywords;
+
+#define CREATE_MIGRATIONS_TABLE_REQUEST                                     \
+    "CREATE TABLE IF NOT EXISTS `schema_migrations` "                       \
+    "("                                                                     \
+        "`component` " "VARCHAR(64) " "NOT NULL, "                          \
+        "`version` " "INT UNSIGNED " "NOT NULL, "                           \
+        "`description` " "VARCHAR(256) " "NOT NULL, "                       \
+        "`applied_at` " "DATETIME " "DEFAULT CURRENT_TIMESTAMP, "           \
+        "PRIMARY KEY (`component`, `version`)"                              \
+    ")"
+
+#define SELECT_APPLIED_VERSION_REQUEST \
+    "SELECT COALESCE(MAX(version), 0) FROM `schema_migrations` WHERE component=?"
+
+#define INSERT_APPLIED_VERSION_REQUEST \
+    "INSERT INTO `schema_migrations` (component, version, description) VALUES(?, ?, ?)"
+
+#define GET_LOCK_REQUEST     "SELECT COALESCE(GET_LOCK(?, ?), 0)"
+#define RELEASE_LOCK_REQUEST "SELECT RELEASE_LOCK(?)"
+
+namespace {
+
+    constexpr const unsigned int kLockTimeout = 60;
+
+    /* ER_DUP_FIELDNAME, ER_DUP_KEYNAME, ER_CANT_DROP_FIELD_OR_KEY */
+    constexpr const int kAlreadyAppliedErrors[] = { 1060, 1061, 1091 };
+    constexpr const char* const kAlreadyAppliedMessages[] = {
+        "Duplicate column name", "Duplicate key name", "check that column/key exists"
+    };
+
+} // namespace [ Constants ]
+
+namespace {
+
+    /* Старые версии Poco кладут код ошибки MySQL только в текст сообщения */
+    bool IsAlreadyApplied(const Poco::Data::MySQL::StatementException& e) {
+        for ( int code : kAlreadyAppliedErrors ) {
+            if ( e.code() == code ) return true;
+        }
+        for ( const char* message : kAlreadyAppliedMessages ) {
+            if ( e.message().find(message) != std::string::npos ) return true;
+        }
+        return false;
+    }
+
+    /* Именованная блокировка MySQL живет на соединении сессии и снимается при выходе из области */
+    class MigrationLock {
+    public:
+        MigrationLock(Poco::Data::Session& session, std::string name, std::string hint) :
+            session_(session), name_(std::move(name)), hint_(std::move(hint)) {
+
+            int acquired = 0;
+            unsigned int timeout = kLockTimeout;
+            session_ << GET_LOCK_REQUEST " " + hint_, use(name_), use(timeout), into(acquired), now;
+            if ( acquired != 1 ) {
+                throw std::runtime_error("Schema migration lock timeout: " + name_);
+            }
+        }
+
+        ~MigrationLock() {
+            try {
+                session_ << RELEASE_LOCK_REQUEST " " + hint_, use(name_), now;
+            } catch ( const std::exception& e ) {
+                std::cerr << "Schema migration unlock error: " << e.what() << std::endl;
+            }
+        }
+
+    private:
+        Poco::Data::Session& session_;
+        std::string name_;
+        std::string hint_;
+    };
+
+} // namespace [ Functions ]
+
+namespace search_service {
+
+    std::string OnlineAddIndex(const std::string& table, const std::string& index,
+                               const std::string& columns, bool unique) {
+        return "ALTER TABLE `" + table + "` ADD " + (unique ? "UNIQUE " : "") + "INDEX `" + index + "` (" + columns + "), "
+               "ALGORITHM=INPLACE, LOCK=NONE";
+    }
+
+    MigrationRunner::MigrationRunner(std::string component, std::vector<Migration> migrations) :
+        component_(std::move(component)),
+        migrations_(std::move(migrations)) {
+
+        std::sort(migrations_.begin(), migrations_.end(), [](const Migration& lhs, const Migration& rhs) {
+            return lhs.version < rhs.version;
+        });
+    }
+
+    unsigned int MigrationRunner::Apply(Poco::Data::Session& session, const std::string& hint) const {
+        session << CREATE_MIGRATIONS_TABLE_REQUEST " " + hint, now;
+
+        MigrationLock lock(session, "schema_migrations:" + component_, hint);
+
+        std::string component = component_;
+        unsigned int applied_version = 0;
+        session << SELECT_APPLIED_VERSION_REQUEST " " + hint, use(component), into(applied_version), now;
+
+        unsigned int applied = 0;
+        for ( const Migration& migration : migrations_ ) {
+            if ( migration.version <= applied_version ) continue;
+
+            std::cout << "Schema migration " << component_ << " v" << migration.version << ": "
+                      << migration.description << " " << hint << std::endl;
+
+            for ( const std::string& statement : migration.statements ) {
+                try {
+                    session << statement + " " + hint, now;
+                } catch ( Poco::Data::MySQL::StatementException& e ) {
+                    if ( !IsAlreadyApplied(e) ) throw;
+                    std::cout << "Schema migration step already applied: " << e.message() << std::endl;
+                }
+            }
+
+            unsigned int version = migration.version;
+            std::string description = migration.description;
+            session << INSERT_APPLIED_VERSION_REQUEST " " + hint, use(component), use(version), use(description), now;
+            applied++;
+        }
+        return applied;
+    }
+
+} // namespace search_service
@@ -0,0 +1,46 @@
+#ifndef SERVER_SCHEMA_MIGRATIONS_H
+#define SERVER_SCHEMA_MIGRATIONS_H
+
+#include <Poco/Data/Session.h>
+
+#include <string>
+#include <vector>
+
+namespace search_service {
+
+    /* Версионированное изменение схемы. Версии внутри компонента уникальны. */
+    struct Migration {
+        unsigned int version;
+        std::string description;
+        std::vector<std::string> statements;
+    };
+
+    /* ALTER TABLE ... ADD INDEX в режиме online DDL: таблица остается доступной на запись */
+    std::string OnlineAddIndex(const std::string& table, const std::string& index,
+                               const std::string& columns, bool unique = false);
+
+    /**
+     * @brief Применение миграций схемы по порядку версий.
+     * @details Примененные версии хранятся в таблице schema_migrations того же сервера,
+     * поэтому при шардировании runner вызывается для сессии каждого шарда. Одновременный
+     * старт нескольких экземпляров сериализуется через GET_LOCK. Если объект миграции уже
+     * существует (индекс создан вручную или вместе с таблицей), шаг считается выполненным.
+     */
+    class MigrationRunner {
+    public:
+        MigrationRunner(std::string component, std::vector<Migration> migrations);
+
+        /**
+         * @param hint - комментарий шардирования ProxySQL, дописывается к каждому запросу.
+         * @return Число примененных миграций.
+         */
+        unsigned int Apply(Poco::Data::Session& session, const std::string& hint = "") const;
+
+    private:
+        std::string component_;
+        std::vector<Migration> migrations_;
+    };
+
+} // namespace search_service
+
+#endif //SERVER_SCHEMA_MIGRATIONS_H
@@ -0,0 +1,166 @@
+-- Общие функции сценариев wrk: распределения ключей, авторизация, формы и отчет в JSON.
+-- Параметры сценариев задаются переменными окружения, см. run_scenarios.sh.
+
+local common = {}
+
+function common.env(name, default)
+   local value = os.getenv(name)
+   if value == nil or value == "" then
+      return default
+   end
+   return value
+end
+
+function common.env_number(name, default)
+   return tonumber(common.env(name, nil)) or default
+end
+
+-- Случайное зерно из /dev/urandom: у каждого потока wrk свое состояние Lua
+function common.seed()
+   local frandom = io.open("/dev/urandom", "rb")
+   local d = frandom:read(4)
+   frandom:close()
+   math.randomseed(d:byte(1) + (d:byte(2) * 256) + (d:byte(3) * 65536) + (d:byte(4) * 16777216))
+end
+
+function common.uniform(n)
+   return function()
+      return math.random(1, n)
+   end
+end
+
+-- Распределение Ципфа: ключ k выбирается с вероятностью ~ 1 / k^s, ключ 1 самый горячий
+function common.zipf(n, s)
+   local cdf = {}
+   local sum = 0
+   for k = 1, n do
+      sum = sum + 1 / (k ^ s)
+      cdf[k] = sum
+   end
+   for k = 1, n do
+      cdf[k] = cdf[k] / sum
+   end
+
+   return function()
+      local u = math.random()
+      local lo, hi = 1, n
+      while lo < hi do
+         local mid = math.floor((lo + hi) / 2)
+         if cdf[mid] < u then
+            lo = mid + 1
+         else
+            hi = mid
+         end
+      end
+      return lo
+   end
+end
+
+-- KEY_DISTRIBUTION=uniform|zipf, ZIPF_S - показатель распределения
+function common.key_sampler(keys)
+   if common.env("KEY_DISTRIBUTION", "zipf") == "uniform" then
+      return common.uniform(keys)
+   end
+   return common.zipf(keys, common.env_number("ZIPF_S", 1.1))
+end
+
+local base64_alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+
+function common.base64(str)
+   local out = {}
+   for i = 1, #str, 3 do
+      local a, b, c = str:byte(i, i + 2)
+      local n = a * 65536 + (b or 0) * 256 + (c or 0)
+      local chars = 4
+      if b == nil then chars = 2 elseif c == nil then chars = 3 end
+
+      for j = 1, 4 do
+         if j <= chars then
+            local index = math.floor(n / (64 ^ (4 - j))) % 64
+            out[#out + 1] = base64_alphabet:sub(index + 1, index + 1)
+         else
+            out[#out + 1] = "="
+         end
+      end
+   end
+   return table.concat(out)
+end
+
+function common.basic_auth(login, password)
+   return "Basic " .. common.base64(login .. ":" .. password)
+end
+
+function common.urlencode(str)
+   return (tostring(str):gsub("[^%w%-%._~]", function(c)
+      return string.format("%%%02X", c:byte())
+   end))
+end
+
+-- Поля в порядке перечисления: { {"login", "a"}, {"password", "b"} }
+function common.form(fields)
+   local parts = {}
+   for _, field in ipairs(fields) do
+      parts[#parts + 1] = field[1] .. "=" .. common.urlencode(field[2])
+   end
+   return table.concat(parts, "&")
+end
+
+-- Выбор операции по весам: { {"read", 0.9}, {"write", 0.1} }
+function common.pick(weights)
+   local total = 0
+   for _, entry in ipairs(weights) do
+      total = total + entry[2]
+   end
+   local u = math.random() * total
+   for _, entry in ipairs(weights) do
+      u = u - entry[2]
+      if u <= 0 then
+         return entry[1]
+      end
+   end
+   return weights[#weights][1]
+end
+
+-- Уникальный префикс потока для создаваемых записей
+local thread_counter = 0
+
+function common.setup_thread(thread)
+   thread_counter = thread_counter + 1
+   thread:set("thread_id", thread_counter)
+end
+
+-- Сводка прогона в JSON: в файл RESULT_FILE и в stdout
+function common.report(scenario, summary, latency, write_ratio)
+   local duration_sec = summary.duration / 1000000
+   local errors = summary.errors
+   local percentiles = { 50, 75, 90, 99, 99.9 }
+
+   local latency_fields = {}
+   for _, p in ipairs(percentiles) do
+      local name = (tostring(p):gsub("%.", "_"))
+      latency_fields[#latency_fields + 1] = string.format('"p%s": %d', name, math.floor(latency:percentile(p)))
+   end
+   latency_fields[#latency_fields + 1] = string.format('"mean": %.2f', latency.mean)
+   latency_fields[#latency_fields + 1] = string.format('"stdev": %.2f', latency.stdev)
+   latency_fields[#latency_fields + 1] = string.format('"max": %d', math.floor(latency.max))
+
+   local json = string.format(
+      '{"scenario": "%s", "key_distribution": "%s", "write_ratio": %s, "duration_us": %d, ' ..
+      '"requests": %d, "bytes": %d, "rps": %.2f, ' ..
+      '"errors": {"connect": %d, "read": %d, "write": %d, "status": %d, "timeout": %d}, ' ..
+      '"latency_us": {%s}}',
+      scenario, common.env("KEY_DISTRIBUTION", "zipf"), write_ratio ~= nil and tostring(write_ratio) or "null",
+      summary.duration, summary.requests, summary.bytes, summary.requests / duration_sec,
+      errors.connect, errors.read, errors.write, errors.status, errors.timeout,
+      table.concat(latency_fields, ", "))
+
+   local path = common.env("RESULT_FILE", nil)
+   if path ~= nil then
+      local file = io.open(path, "w")
+      file:write(json, "\n")
+      file:close()
+   end
+   io.write(json, "\n")
+end
+
+return common
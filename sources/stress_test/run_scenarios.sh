@@ -0,0 +1,94 @@
+#!/bin/bash
+#
+# Набор нагрузочных сценариев wrk для всех сервисов.
+# Результаты каждого прогона пишутся в ${RESULTS_DIR}/<сценарий>_c<подключения>.json,
+# сводка всех прогонов - в ${RESULTS_DIR}/summary.json.
+#
+# Параметры (переменные окружения):
+#   USERS_URL, ARTICLES_URL, CONFERENCE_URL - адреса сервисов
+#   SCENARIOS         - список сценариев из scenarios/ без расширения
+#   CONNECTIONS       - список числа подключений; потоков wrk столько же, но не больше THREADS_MAX
+#   DURATION          - длительность одного прогона, секунд
+#   KEY_DISTRIBUTION  - uniform | zipf, ZIPF_S - показатель распределения Ципфа
+#   WRITE_RATIO       - доля записей в смешанных сценариях
+#   USER_KEYS, ARTICLE_KEYS - диапазон id для чтения
+#   STRESS_USERS      - число пользователей stress_user_<k>, создаваемых перед прогоном (SEED_USERS=ON)
+#   MODERATOR_LOGIN, MODERATOR_PASSWORD - учетная запись с ролью moderator для conference_flow
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+
+USERS_URL="${USERS_URL:-http://localhost:8080}"
+ARTICLES_URL="${ARTICLES_URL:-http://localhost:8081}"
+CONFERENCE_URL="${CONFERENCE_URL:-http://localhost:8082}"
+
+SCENARIOS="${SCENARIOS:-users_get users_auth users_search users_register users_mixed articles_crud conference_flow}"
+CONNECTIONS="${CONNECTIONS:-1 2 5 10}"
+THREADS_MAX="${THREADS_MAX:-$(nproc)}"
+DURATION="${DURATION:-10}"
+RESULTS_DIR="${RESULTS_DIR:-${SCRIPT_DIR}/results}"
+SEED_USERS="${SEED_USERS:-ON}"
+
+export KEY_DISTRIBUTION="${KEY_DISTRIBUTION:-zipf}"
+export ZIPF_S="${ZIPF_S:-1.1}"
+export STRESS_USERS="${STRESS_USERS:-1000}"
+export STRESS_PASSWORD="${STRESS_PASSWORD:-StressPass00}"
+
+service_url() {
+  case "$1" in
+    users_*)      echo "${USERS_URL}" ;;
+    articles_*)   echo "${ARTICLES_URL}" ;;
+    conference_*) echo "${CONFERENCE_URL}" ;;
+  esac
+}
+
+# Пользователи stress_user_<k> для сценариев с авторизацией. Уже существующие отвечают 409.
+seed_users() {
+  echo "========== Seeding ${STRESS_USERS} users ================"
+  for k in $(seq 1 "${STRESS_USERS}"); do
+    curl -s -o /dev/null -X POST "${USERS_URL}/user" \
+         --data-urlencode "first_name=Stress${k}" \
+         --data-urlencode "last_name=User${k}" \
+         --data-urlencode "middle_name=Seed" \
+         --data-urlencode "email=stress_user_${k}@stress.test" \
+         --data-urlencode "gender=male" \
+         --data-urlencode "login=stress_user_${k}" \
+         --data-urlencode "password=${STRESS_PASSWORD}"
+  done
+}
+
+mkdir -p "${RESULTS_DIR}"
+cd "${SCRIPT_DIR}"
+
+if [[ "${SEED_USERS}" == "ON" ]]; then
+  seed_users
+fi
+
+RESULT_FILES=()
+for scenario in ${SCENARIOS}; do
+  url="$(service_url "${scenario}")"
+  for connections in ${CONNECTIONS}; do
+    threads=$(( connections < THREADS_MAX ? connections : THREADS_MAX ))
+    result_file="${RESULTS_DIR}/${scenario}_c${connections}.json"
+
+    echo "========== ${scenario}: ${threads} threads, ${connections} connections ================"
+    RESULT_FILE="${result_file}" \
+      wrk -d "${DURATION}" -t "${threads}" -c "${connections}" --latency \
+          -s "scenarios/${scenario}.lua" "${url}"
+
+    RESULT_FILES+=("${result_file}")
+  done
+done
+
+{
+  echo "["
+  for i in "${!RESULT_FILES[@]}"; do
+    separator=","
+    [[ $i -eq $(( ${#RESULT_FILES[@]} - 1 )) ]] && separator=""
+    echo "  $(cat "${RESULT_FILES[$i]}")${separator}"
+  done
+  echo "]"
+} > "${RESULTS_DIR}/summary.json"
+
+echo "Summary: ${RESULTS_DIR}/summary.json"
@@ -0,0 +1,75 @@
+-- CRUD статей: чтение по id, пакетное чтение, создание и удаление созданных этим потоком статей.
+-- Доля записей WRITE_RATIO делится между созданием и удалением.
+package.path = "./lib/?.lua;" .. package.path
+local common = require("common")
+
+local sample
+local auth
+local write_ratio = common.env_number("WRITE_RATIO", 0.1)
+local counter = 0
+
+-- id статей, созданных потоком и еще не удаленных
+local created = {}
+local deleted = {}
+
+function setup(thread)
+   common.setup_thread(thread)
+end
+
+function init(args)
+   common.seed()
+   sample = common.key_sampler(common.env_number("ARTICLE_KEYS", 1000))
+   auth = {}
+   auth["Authorization"] = common.basic_auth(common.env("STRESS_LOGIN", "stress_user_1"),
+                                             common.env("STRESS_PASSWORD", "StressPass00"))
+end
+
+function request()
+   local operation = common.pick({
+      { "get", (1 - write_ratio) * 0.8 },
+      { "batch", (1 - write_ratio) * 0.2 },
+      { "create", write_ratio / 2 },
+      { "delete", write_ratio / 2 },
+   })
+
+   if operation == "delete" and #created > 0 then
+      local id = table.remove(created, math.random(1, #created))
+      deleted[id] = true
+      return wrk.format("DELETE", "/article?id=" .. id, auth)
+   end
+
+   if operation == "create" or operation == "delete" then
+      counter = counter + 1
+      local query = common.form({
+         { "title", "Stress article " .. thread_id .. "-" .. counter },
+         { "description", "Load test article" },
+         { "content", string.rep("Lorem ipsum dolor sit amet. ", 40) },
+      })
+      return wrk.format("POST", "/article?" .. query, auth)
+   end
+
+   if operation == "batch" then
+      local ids = {}
+      for i = 1, 20 do
+         ids[i] = sample()
+      end
+      return wrk.format("GET", "/articles?ids=" .. table.concat(ids, ","), auth)
+   end
+
+   return wrk.format("GET", "/article?id=" .. sample(), auth)
+end
+
+-- Ответ на создание содержит id верхнего уровня и не содержит тела статьи
+function response(status, headers, body)
+   if status ~= 200 or body:find('"article"', 1, true) or body:find('"articles"', 1, true) then
+      return
+   end
+   local id = tonumber(body:match('"id"%s*:%s*"?(%d+)'))
+   if id ~= nil and not deleted[id] then
+      created[#created + 1] = id
+   end
+end
+
+function done(summary, latency, requests)
+   common.report("articles_crud", summary, latency, write_ratio)
+end
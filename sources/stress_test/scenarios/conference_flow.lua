@@ -0,0 +1,51 @@
+-- Конференция: листание принятых статей, проверка статьи и принятие модератором в доле WRITE_RATIO.
+-- Учетной записи MODERATOR_LOGIN нужна роль не ниже moderator, иначе принятия завершаются 403.
+package.path = "./lib/?.lua;" .. package.path
+local common = require("common")
+
+local sample
+local reader_auth
+local moderator_auth
+local write_ratio = common.env_number("WRITE_RATIO", 0.05)
+local page_size = common.env_number("PAGE_SIZE", 20)
+local pages = common.env_number("PAGES", 50)
+local page_sample
+
+function setup(thread)
+   common.setup_thread(thread)
+end
+
+function init(args)
+   common.seed()
+   sample = common.key_sampler(common.env_number("ARTICLE_KEYS", 1000))
+   -- Первые страницы читают чаще последних
+   page_sample = common.key_sampler(pages)
+
+   reader_auth = {}
+   reader_auth["Authorization"] = common.basic_auth(common.env("STRESS_LOGIN", "stress_user_1"),
+                                                    common.env("STRESS_PASSWORD", "StressPass00"))
+   moderator_auth = {}
+   moderator_auth["Authorization"] = common.basic_auth(common.env("MODERATOR_LOGIN", "stress_user_1"),
+                                                       common.env("MODERATOR_PASSWORD", "StressPass00"))
+end
+
+function request()
+   local operation = common.pick({
+      { "list", (1 - write_ratio) * 0.7 },
+      { "get", (1 - write_ratio) * 0.3 },
+      { "accept", write_ratio },
+   })
+
+   if operation == "accept" then
+      return wrk.format("POST", "/article?id=" .. sample(), moderator_auth)
+   elseif operation == "get" then
+      return wrk.format("GET", "/article?id=" .. sample(), reader_auth)
+   end
+
+   local offset = (page_sample() - 1) * page_size
+   return wrk.format("GET", "/search?hydrate=true&limit=" .. page_size .. "&offset=" .. offset, reader_auth)
+end
+
+function done(summary, latency, requests)
+   common.report("conference_flow", summary, latency, write_ratio)
+end
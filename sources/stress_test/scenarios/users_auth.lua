@@ -0,0 +1,25 @@
+-- GET /auth пользователями, созданными run_scenarios.sh (stress_user_<k>).
+package.path = "./lib/?.lua;" .. package.path
+local common = require("common")
+
+local sample
+local password = common.env("STRESS_PASSWORD", "StressPass00")
+
+function setup(thread)
+   common.setup_thread(thread)
+end
+
+function init(args)
+   common.seed()
+   sample = common.key_sampler(common.env_number("STRESS_USERS", 1000))
+end
+
+function request()
+   local headers = {}
+   headers["Authorization"] = common.basic_auth("stress_user_" .. sample(), password)
+   return wrk.format("GET", "/auth", headers)
+end
+
+function done(summary, latency, requests)
+   common.report("users_auth", summary, latency)
+end
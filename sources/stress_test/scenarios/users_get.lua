@@ -0,0 +1,23 @@
+-- GET /user?id= с ключами из KEY_DISTRIBUTION. NO_CACHE=ON обходит кэш.
+package.path = "./lib/?.lua;" .. package.path
+local common = require("common")
+
+local sample
+local path = common.env("NO_CACHE", "OFF") == "ON" and "/user?no_cache&id=" or "/user?id="
+
+function setup(thread)
+   common.setup_thread(thread)
+end
+
+function init(args)
+   common.seed()
+   sample = common.key_sampler(common.env_number("USER_KEYS", 1000))
+end
+
+function request()
+   return wrk.format("GET", path .. sample())
+end
+
+function done(summary, latency, requests)
+   common.report("users_get", summary, latency)
+end
@@ -0,0 +1,59 @@
+-- Смесь чтений users_service (профиль, поиск, авторизация) и регистраций в доле WRITE_RATIO.
+package.path = "./lib/?.lua;" .. package.path
+local common = require("common")
+
+local sample
+local counter = 0
+local run_id
+local password = common.env("STRESS_PASSWORD", "StressPass00")
+local write_ratio = common.env_number("WRITE_RATIO", 0.1)
+
+function setup(thread)
+   common.setup_thread(thread)
+end
+
+function init(args)
+   common.seed()
+   sample = common.key_sampler(common.env_number("STRESS_USERS", 1000))
+   run_id = string.format("%08x", math.random(0, 2147483646))
+end
+
+local function auth_headers(k)
+   local headers = {}
+   headers["Authorization"] = common.basic_auth("stress_user_" .. k, password)
+   return headers
+end
+
+function request()
+   local operation = common.pick({
+      { "get", (1 - write_ratio) * 0.6 },
+      { "search", (1 - write_ratio) * 0.2 },
+      { "auth", (1 - write_ratio) * 0.2 },
+      { "register", write_ratio },
+   })
+   local k = sample()
+
+   if operation == "get" then
+      return wrk.format("GET", "/user?id=" .. k)
+   elseif operation == "search" then
+      local query = common.form({ { "first_name", "Stress" .. k .. "%" }, { "last_name", "User%" } })
+      return wrk.format("GET", "/search?" .. query, auth_headers(k))
+   elseif operation == "auth" then
+      return wrk.format("GET", "/auth", auth_headers(k))
+   end
+
+   counter = counter + 1
+   local login = "mix_" .. run_id .. "_" .. thread_id .. "_" .. counter
+   local headers = {}
+   headers["Content-Type"] = "application/x-www-form-urlencoded"
+   local body = common.form({
+      { "first_name", "Mixed" }, { "last_name", "Stress" }, { "middle_name", "Load" },
+      { "email", login .. "@stress.test" }, { "gender", "female" },
+      { "login", login }, { "password", password },
+   })
+   return wrk.format("POST", "/user", headers, body)
+end
+
+function done(summary, latency, requests)
+   common.report("users_mixed", summary, latency, write_ratio)
+end
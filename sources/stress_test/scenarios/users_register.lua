@@ -0,0 +1,36 @@
+-- POST /user с уникальными логинами: поток + случайный префикс прогона + счетчик.
+package.path = "./lib/?.lua;" .. package.path
+local common = require("common")
+
+local counter = 0
+local run_id
+
+function setup(thread)
+   common.setup_thread(thread)
+end
+
+function init(args)
+   common.seed()
+   run_id = string.format("%08x", math.random(0, 2147483646))
+end
+
+function request()
+   counter = counter + 1
+   local login = "reg_" .. run_id .. "_" .. thread_id .. "_" .. counter
+   local headers = {}
+   headers["Content-Type"] = "application/x-www-form-urlencoded"
+   local body = common.form({
+      { "first_name", "Register" },
+      { "last_name", "Stress" },
+      { "middle_name", "Load" },
+      { "email", login .. "@stress.test" },
+      { "gender", "male" },
+      { "login", login },
+      { "password", "StressPass00" },
+   })
+   return wrk.format("POST", "/user", headers, body)
+end
+
+function done(summary, latency, requests)
+   common.report("users_register", summary, latency)
+end
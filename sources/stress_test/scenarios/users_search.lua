@@ -0,0 +1,27 @@
+-- Авторизованный GET /search по маске имени созданных пользователей.
+package.path = "./lib/?.lua;" .. package.path
+local common = require("common")
+
+local sample
+local password = common.env("STRESS_PASSWORD", "StressPass00")
+
+function setup(thread)
+   common.setup_thread(thread)
+end
+
+function init(args)
+   common.seed()
+   sample = common.key_sampler(common.env_number("STRESS_USERS", 1000))
+end
+
+function request()
+   local k = sample()
+   local headers = {}
+   headers["Authorization"] = common.basic_auth("stress_user_" .. k, password)
+   local query = common.form({ { "first_name", "Stress" .. k .. "%" }, { "last_name", "User%" } })
+   return wrk.format("GET", "/search?" .. query, headers)
+end
+
+function done(summary, latency, requests)
+   common.report("users_search", summary, latency)
+end
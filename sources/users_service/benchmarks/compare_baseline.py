@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""
+Прогон микробенчмарков и сравнение с сохраненным базовым прогоном.
+
+    compare_baseline.py <build>/users_service/benchmarks            # сравнение, код 1 при регрессии
+    compare_baseline.py <build>/users_service/benchmarks --update   # сохранение нового базового прогона
+
+Сравнивается медиана cpu_time по повторам. Регрессия - замедление больше порога в процентах.
+
+Базовый прогон хранится в репозитории рядом со скриптом (benchmarks/baseline.json) и
+снимается с --update на той машине, где затем идут сравнения. Обновляется отдельным
+коммитом вместе с изменением, которое намеренно меняет скорость. Без файла базового
+прогона сравнение завершается ошибкой: первый прогон не должен проходить сам собой.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+DEFAULT_BASELINE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "baseline.json")
+DEFAULT_THRESHOLD = 10.0
+DEFAULT_REPETITIONS = 5
+
+
+def run_benchmarks(binary, repetitions, benchmark_filter):
+    with tempfile.NamedTemporaryFile(suffix=".json", delete=False) as out:
+        out_path = out.name
+    try:
+        command = [binary,
+                   "--benchmark_out=" + out_path,
+                   "--benchmark_out_format=json",
+                   "--benchmark_repetitions=" + str(repetitions),
+                   "--benchmark_report_aggregates_only=true"]
+        if benchmark_filter:
+            command.append("--benchmark_filter=" + benchmark_filter)
+        subprocess.run(command, check=True)
+        with open(out_path) as result:
+            report = json.load(result)
+    finally:
+        os.remove(out_path)
+
+    medians = {}
+    for entry in report["benchmarks"]:
+        if entry.get("run_type") == "aggregate" and entry.get("aggregate_name") == "median":
+            medians[entry["run_name"]] = {"cpu_time": entry["cpu_time"], "time_unit": entry["time_unit"]}
+    return medians
+
+
+def compare(baseline, current, threshold):
+    regressions = []
+    print("{:<50} {:>14} {:>14} {:>9}".format("benchmark", "baseline", "current", "change"))
+    for name, result in sorted(current.items()):
+        base = baseline.get(name)
+        if base is None or base["time_unit"] != result["time_unit"]:
+            print("{:<50} {:>14} {:>12.1f}{:>2} {:>9}".format(name, "-", result["cpu_time"], result["time_unit"], "new"))
+            continue
+
+        change = (result["cpu_time"] - base["cpu_time"]) / base["cpu_time"] * 100.0
+        mark = " !" if change > threshold else ""
+        print("{:<50} {:>12.1f}{:>2} {:>12.1f}{:>2} {:>+8.1f}%{}".format(
+            name, base["cpu_time"], base["time_unit"], result["cpu_time"], result["time_unit"], change, mark))
+        if change > threshold:
+            regressions.append(name)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("binary", help="путь к собранной цели benchmarks")
+    parser.add_argument("--baseline", default=DEFAULT_BASELINE, help="файл базового прогона")
+    parser.add_argument("--threshold", type=float, default=DEFAULT_THRESHOLD, help="допустимое замедление, %%")
+    parser.add_argument("--repetitions", type=int, default=DEFAULT_REPETITIONS)
+    parser.add_argument("--filter", default="", help="регулярное выражение для --benchmark_filter")
+    parser.add_argument("--update", action="store_true", help="перезаписать базовый прогон")
+    args = parser.parse_args()
+
+    if not args.update and not os.path.exists(args.baseline):
+        print("Baseline " + args.baseline + " not found, record it with --update", file=sys.stderr)
+        return 2
+
+    current = run_benchmarks(args.binary, args.repetitions, args.filter)
+
+    if args.update:
+        with open(args.baseline, "w") as out:
+            json.dump(current, out, indent=2, sort_keys=True)
+        print("Baseline saved to " + args.baseline)
+        return 0
+
+    with open(args.baseline) as baseline_file:
+        baseline = json.load(baseline_file)
+
+    regressions = compare(baseline, current, args.threshold)
+    if regressions:
+        print("\nRegressions over {:.1f}%: {}".format(args.threshold, ", ".join(regressions)))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,187 @@
+#include <benchmark/benchmark.h>
+
+#include <Poco/Base64Encoder.h>
+#include <Poco/DateTimeFormat.h>
+#include <Poco/JSON/Stringifier.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/NullStream.h>
+
+#include "database/database.h"
+#include "database/db_id_index.h"
+#include "database/user.h"
+
+#include "../service/handlers/auth/auth_handler.h"
+#include "../service/handlers/interface/handler_factory.h"
+
+#include "errors.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Микробенчмарки горячих участков users_service, не требующих БД и сети.
+ * Сравнение с сохраненным базовым прогоном: benchmarks/compare_baseline.py.
+ */
+
+namespace {
+
+    const std::vector<std::string> kRoutedURIs = {
+        "/user?id=42",
+        "/user/role",
+        "/auth",
+        "/search?first_name=Ivan&last_name=Ivanov",
+        "/unknown"
+    };
+
+} // namespace [ Constants ]
+
+namespace {
+
+    database::User MakeUser() {
+        database::User user;
+        user.ID()         = 12345;
+        user.FirstName()  = "Ivan";
+        user.LastName()   = "Ivanov";
+        user.MiddleName() = "Ivanovich";
+        user.EMail()      = "ivan.ivanov@example.com";
+        user.Gender()     = "male";
+        user.Login()      = "ivan.ivanov";
+        user.Password()   = "HelloWorld00";
+        user.Role()       = database::UserRole(database::UserRole::User);
+        return user;
+    }
+
+    std::string EncodeBase64(const std::string& str) {
+        std::ostringstream encoded;
+        Poco::Base64Encoder encoder(encoded);
+        encoder << str;
+        encoder.close();
+        return encoded.str();
+    }
+
+    /* Ответ без сокета: тело уходит в NullOutputStream */
+    class NullServerResponse : public Poco::Net::HTTPServerResponse {
+    public:
+        void sendContinue() override {}
+        std::ostream& send() override { return stream_; }
+        std::pair<std::ostream*, std::ostream*> beginSend() override { return { &stream_, &stream_ }; }
+        void sendFile(const std::string&, const std::string&) override {}
+        void sendBuffer(const void*, std::size_t) override {}
+        void redirect(const std::string&, HTTPStatus) override {}
+        void requireAuthentication(const std::string&) override {}
+        bool sent() const override { return false; }
+
+    private:
+        Poco::NullOutputStream stream_;
+    };
+
+    /* Открывает защищенные построители ответов об ошибках */
+    class ErrorResponseHandler : public handler::IRequestHandler {
+    public:
+        ErrorResponseHandler() : IRequestHandler(Poco::DateTimeFormat::SORTABLE_FORMAT, handler::HandlerType::User, "/user") {}
+
+        void handleRequest(HTTPServerRequest&, HTTPServerResponse&) override {}
+
+        using IRequestHandler::SetBadRequestResponse;
+        using IRequestHandler::SetNotFoundResponse;
+        using IRequestHandler::SetConflictResponse;
+        using IRequestHandler::SetInternalErrorResponse;
+    };
+
+} // namespace [ Functions ]
+
+static void BM_UserSerialize(benchmark::State& state) {
+    database::User user = MakeUser();
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize(user.Serialize());
+    }
+}
+BENCHMARK(BM_UserSerialize);
+
+static void BM_UserDeserialize(benchmark::State& state) {
+    std::string serialized = MakeUser().Serialize();
+    for ( auto _ : state ) {
+        database::User user;
+        user.Deserialize(serialized);
+        benchmark::DoNotOptimize(user);
+    }
+}
+BENCHMARK(BM_UserDeserialize);
+
+static void BM_UserToJSON(benchmark::State& state) {
+    database::User user = MakeUser();
+    for ( auto _ : state ) {
+        std::ostringstream ostr;
+        Poco::JSON::Stringifier::stringify(user.ToJSON(), ostr);
+        benchmark::DoNotOptimize(ostr);
+    }
+}
+BENCHMARK(BM_UserToJSON);
+
+static void BM_DBIDIndexFromExternID(benchmark::State& state) {
+    long id = 1;
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize(database::DB_ID_Index::FromExternID(id++).GetDBID());
+    }
+}
+BENCHMARK(BM_DBIDIndexFromExternID);
+
+static void BM_DBIDIndexFromDBID(benchmark::State& state) {
+    long id = 1;
+    for ( auto _ : state ) {
+        size_t shard_id = static_cast<size_t>(id % 2);
+        benchmark::DoNotOptimize(database::DB_ID_Index::FromDBID(id++, shard_id).GetExternalID());
+    }
+}
+BENCHMARK(BM_DBIDIndexFromDBID);
+
+static void BM_UserShardingHint(benchmark::State& state) {
+    std::string login = "ivan.ivanov@example.com";
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize(database::Database::UserShardingHint(login));
+    }
+}
+BENCHMARK(BM_UserShardingHint);
+
+static void BM_HandlerFactoryCreate(benchmark::State& state) {
+    const std::string& uri = kRoutedURIs[static_cast<size_t>(state.range(0))];
+    state.SetLabel(uri);
+    for ( auto _ : state ) {
+        try {
+            std::unique_ptr<handler::IRequestHandler> created(
+                    handler::HandlerFactory::Create(Poco::DateTimeFormat::SORTABLE_FORMAT, uri));
+            benchmark::DoNotOptimize(created.get());
+        } catch ( const exceptions::BadURI& e ) {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+}
+BENCHMARK(BM_HandlerFactoryCreate)->DenseRange(0, static_cast<int>(kRoutedURIs.size()) - 1);
+
+static void BM_ParseBasicCredentials(benchmark::State& state) {
+    std::string base64 = EncodeBase64("ivan.ivanov@example.com:HelloWorld00");
+    for ( auto _ : state ) {
+        benchmark::DoNotOptimize(handler::AuthHandler::ParseBasicCredentials(base64));
+    }
+}
+BENCHMARK(BM_ParseBasicCredentials);
+
+static void BM_ErrorResponse(benchmark::State& state) {
+    ErrorResponseHandler handler;
+    NullServerResponse response;
+    const std::string description = "User with current login is exists.";
+
+    for ( auto _ : state ) {
+        switch ( state.range(0) ) {
+            case 0: handler.SetBadRequestResponse(response, description); break;
+            case 1: handler.SetNotFoundResponse(response, description); break;
+            case 2: handler.SetConflictResponse(response, description); break;
+            default: handler.SetInternalErrorResponse(response, description); break;
+        }
+    }
+}
+BENCHMARK(BM_ErrorResponse)->DenseRange(0, 3);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,163 @@
+#ifndef SEARCH_SERVICE_ASYNC_DATABASE_H
+#define SEARCH_SERVICE_ASYNC_DATABASE_H
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef SEARCH_SERVICE_COROUTINES
+#include <coroutine>
+#endif
+
+struct MYSQL;
+
+namespace search_service { class DatabaseConfig; }
+
+namespace database {
+
+    /* Строка результата в текстовом протоколе MySQL. NULL представлен пустым optional. */
+    using AsyncRow = std::vector<std::optional<std::string>>;
+    using AsyncResult = std::vector<AsyncRow>;
+
+    /**
+     * @brief Неблокирующий доступ к MySQL для параллельных запросов по шардам.
+     * @details Все соединения обслуживаются одним потоком событийного цикла на основе
+     * неблокирующего API libmysqlclient (*_nonblocking). Вызывающий поток только ставит
+     * запрос в очередь и получает future, поэтому опрос N шардов не блокирует N потоков.
+     * Параметры подставляются вместо '?' в виде экранированных строковых литералов.
+     * Ошибки передаются как Poco::Data::MySQL::ConnectionException и StatementException,
+     * запрос, не успевший к сроку, прерывается с exceptions::DeadlineExceeded.
+     */
+    class AsyncDatabase {
+        AsyncDatabase();
+
+    public:
+        using Callback = std::function<void(AsyncResult result, std::exception_ptr error)>;
+        using Clock = std::chrono::steady_clock;
+
+        static AsyncDatabase& Instance();
+
+        ~AsyncDatabase();
+
+        void BindConfigure(std::shared_ptr<search_service::DatabaseConfig> config);
+        void Start();
+        void Stop();
+
+        /* Шард по умолчанию: запрос уходит на основной адрес из конфигурации (ProxySQL) */
+        static constexpr long kDefaultShard = -1;
+
+        /* Чтение с реплики допустимо, если выборка не обязана видеть только что записанные данные */
+        enum class Route {
+            Primary,
+            Replica
+        };
+
+        /* Ограничения запроса по времени */
+        struct Limits {
+            /* Срок, после которого запрос прерывается, а соединение закрывается */
+            std::optional<Clock::time_point> deadline;
+            /* Дублировать запрос на другой адрес шарда, если он дольше p95 этого шарда */
+            bool hedge{ false };
+        };
+
+        /* Ограничения чтения по шардам для текущего запроса: срок запроса и query_timeout_ms */
+        [[nodiscard]] Limits ReadLimits() const;
+
+        /* Обратный вызов выполняется в потоке событийного цикла и не должен блокироваться */
+        void Execute(std::string query, std::vector<std::string> params, Callback callback,
+                     long shard_id = kDefaultShard, Route route = Route::Primary, Limits limits = {});
+
+        std::future<AsyncResult> Query(std::string query, std::vector<std::string> params,
+                                       long shard_id = kDefaultShard, Route route = Route::Primary,
+                                       Limits limits = {});
+
+#ifdef SEARCH_SERVICE_COROUTINES
+        class QueryAwaitable {
+        public:
+            QueryAwaitable(AsyncDatabase& database, std::string query, std::vector<std::string> params, long shard_id);
+
+            [[nodiscard]] bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle);
+            AsyncResult await_resume();
+
+        private:
+            AsyncDatabase& database_;
+            std::string query_;
+            std::vector<std::string> params_;
+            long shard_id_;
+            AsyncResult result_;
+            std::exception_ptr error_;
+        };
+
+        /* Корутина продолжается в потоке событийного цикла */
+        QueryAwaitable QueryAwait(std::string query, std::vector<std::string> params, long shard_id = kDefaultShard);
+#endif
+
+    private:
+        struct Operation;
+        struct Hedge;
+
+        /* Задержки последних успешных запросов к шарду для оценки p95 */
+        struct LatencyWindow {
+            std::vector<double> samples;
+            size_t next{ 0 };
+            size_t recorded{ 0 };
+            std::optional<double> p95;
+        };
+
+        /**
+         * Адрес сервера со своим набором соединений. При прямом подключении к шардам - по одному на шард.
+         * Следом за основными адресами идут реплики в порядке конфигурации.
+         */
+        struct Endpoint {
+            std::string host;
+            unsigned int port;
+            std::vector<MYSQL*> idle;
+            unsigned int open_connections;
+        };
+
+        void Run();
+        void Admit();
+        void Expire();
+        void StartHedge(Operation& operation);
+        void RecordLatency(const Operation& operation);
+        bool Advance(Operation& operation);
+        void Finish(Operation& operation, AsyncResult result, std::exception_ptr error);
+        void Release(Operation& operation, bool reusable);
+        void Wake() noexcept;
+
+    private:
+        std::shared_ptr<search_service::DatabaseConfig> config_;
+        unsigned int max_connections_;
+
+        /* Неблокирующее подключение хранит указатели на параметры между вызовами */
+        std::string login_;
+        std::string password_;
+        std::string database_;
+
+        std::thread thread_;
+        std::atomic<bool> running_;
+        int wake_fd_;
+
+        std::mutex submitted_mtx_;
+        std::deque<std::unique_ptr<Operation>> submitted_;
+
+        /* Используются только потоком событийного цикла */
+        std::vector<std::unique_ptr<Operation>> active_;
+        std::vector<Endpoint> endpoints_;
+        size_t primary_endpoints_;
+        std::vector<LatencyWindow> shard_latency_;
+    };
+
+} // namespace database
+
+#endif // SEARCH_SERVICE_ASYNC_DATABASE_H
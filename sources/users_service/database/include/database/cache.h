@@ -1,29 +1,98 @@
 #ifndef SERVER_CACHE_H
 #define SERVER_CACHE_H
 
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <list>
 #include <string>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include "user.h"
+#include "cache_backend.h"
 
 namespace database
 {
+    /**
+     * @brief Кэш пользователей: локальная копия в памяти процесса поверх CacheBackend.
+     * @details При общем хранилище (Redis) локальная копия не видит записей других
+     * экземпляров сервиса, поэтому изменения рассылаются через InvalidationBus,
+     * а Invalidate() вызывается подписчиком.
+     */
     class Cache
     {
         Cache();
 
     public:
         static Cache* Get();
-        void Init(const std::string& server_ip, unsigned int port, unsigned int expiration=60);
+        void Init(std::unique_ptr<search_service::CacheBackend> backend, unsigned int expiration=60,
+                  unsigned int local_expiration=30, unsigned int local_max_entries=10000);
 
         void Put(long id, const User& val);
         bool Get(long id, User& val);
 
+        /* Удаление записи из хранилища и из локальной копии */
+        void Remove(long id);
+
+        /* Поколение записи, меняется при каждом удалении и инвалидации */
+        uint64_t Generation(long id);
+
+        /* Запись, только если с чтения поколения запись не удаляли и не инвалидировали.
+         * Проверка и запись идут под одной блокировкой с инвалидацией этого id. */
+        bool PutIfGeneration(long id, const User& val, uint64_t generation);
+
+        /* Удаление записи только из локальной копии */
+        void Invalidate(long id);
+        void InvalidateAll();
+
+        /* Запись самых запрашиваемых записей локальной копии в файл снимка, обычно при остановке */
+        size_t SaveSnapshot(const std::string& path, size_t max_entries);
+
+        /* Фоновая загрузка снимка, сохранённого не раньше срока жизни записей в хранилище
+         * (при общем хранилище - срока локальной копии, значения перечитываются из хранилища).
+         * Результат - число загруженных записей, его дожидаются перед приёмом запросов. */
+        std::future<size_t> LoadSnapshot(const std::string& path, bool use_mmap);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct LocalEntry {
+            std::string serialized;
+            Clock::time_point expires_at;
+            unsigned int hits;
+            std::list<long>::iterator lru;
+        };
+
+        void PutLocal(long id, const std::string& serialized);
+        bool GetLocal(long id, std::string& serialized);
+
+        /* Запись в хранилище и в локальную копию */
+        void Store(long id, const User& val);
+
+        /* Поколения ведутся по полосам id: без роста памяти, ценой лишних отказов при совпадении полосы */
+        static constexpr size_t kGenerationStripes = 64;
+        static size_t Stripe(long id) noexcept;
+
+        /* Разбор содержимого файла снимка, возвращает число загруженных записей */
+        size_t RestoreSnapshot(const char* data, size_t size);
+
     private:
-        std::shared_ptr<std::iostream> _stream;
-        std::shared_ptr<std::string>   _expiration;
+        std::unique_ptr<search_service::CacheBackend> _backend;
+        std::array<std::mutex, kGenerationStripes> _generation_mtx;
+        std::array<uint64_t, kGenerationStripes> _generations{ };
+        unsigned int _expiration;
         bool _is_inited;
 
+        std::mutex _local_mtx;
+        std::unordered_map<long, LocalEntry> _local;
+        /* Порядок обращений к локальной копии: в начале последние, при переполнении вытесняется конец */
+        std::list<long> _local_lru;
+        std::chrono::seconds _local_expiration;
+        size_t _local_max_entries;
+
         void SaveToCache();
     };
 
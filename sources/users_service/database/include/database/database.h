@@ -1,20 +1,38 @@
 #ifndef SEARCH_SERVICE_DATABASE_H
 #define SEARCH_SERVICE_DATABASE_H
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
 #include <Poco/Data/MySQL/Connector.h>
 #include <Poco/Data/MySQL/MySQLException.h>
 #include <Poco/Data/SessionFactory.h>
 #include <Poco/Data/SessionPool.h>
 
-namespace search_service { class DatabaseConfig; }
+#include "sharding.h"
+
+namespace search_service {
+    class DatabaseConfig;
+    class ReplicaRouter;
+}
 
 namespace database {
 
-    struct ShardingHint {
-        std::string hint;
-        long shard_id;
+    /* Снимок состояния пула сессий */
+    struct PoolStatistics {
+        int capacity;
+        int allocated;
+        int used;
+        int idle;
+        double wait_ms;
+        double max_wait_ms;
+        uint64_t failed_checks;
+        uint64_t reconnects;
     };
 
     class Database{
@@ -24,21 +42,67 @@ namespace database {
     public:
         static Database& Instance();
 
+        ~Database();
+
         void BindConfigure(std::shared_ptr<search_service::DatabaseConfig> config);
         bool TryConnect();
         bool IsConnected() const noexcept;
 
+        /* Остановка фоновой проверки пула */
+        void Shutdown();
+
         Poco::Data::Session CreateSession();
 
+        /* При прямом подключении к шардам сессия берется из пула шарда hint.shard_id */
+        Poco::Data::Session CreateSession(const ShardingHint& hint);
+
+        [[nodiscard]] bool UsesDirectShards() const noexcept;
+
+        /* Сессия для чтения: реплика шарда, если она не отстает и в шард недавно не писали */
+        Poco::Data::Session CreateReadSession(const ShardingHint& hint);
+
+        /* Закрепление чтений клиента текущего запроса за основным сервером на окно read-your-writes */
+        void NoteWrite();
+
+        /* Выбор реплики для асинхронного чтения. Индекс соответствует порядку database.replicas. */
+        [[nodiscard]] std::optional<size_t> PickReplica(long shard_id);
+        void MarkReplicaFailed(size_t index) noexcept;
+
+        /* Скользящее среднее времени получения сессии из пула, мс. Устаревшие измерения не учитываются. */
+        [[nodiscard]] double GetPoolWaitTime() const noexcept;
+
+        /* Максимальное время ожидания сессии и счетчики сбрасываются при каждом вызове */
+        [[nodiscard]] PoolStatistics GetPoolStatistics();
+
         static size_t GetMaxShard();
         static ShardingHint UserShardingHint(const std::string& login);
         static std::vector<ShardingHint> GetAllHints();
 
+    private:
+        Poco::Data::Session AcquireSession(Poco::Data::SessionPool& pool);
+        std::string BuildConnectionString(const std::string& host, unsigned int port) const;
+        void WarmUp(Poco::Data::SessionPool& pool);
+        bool CheckPool();
+        void HealthCheckLoop();
+
     private:
         bool is_connected_;
         std::string connection_string_;
-        std::unique_ptr<Poco::Data::SessionPool> pool_;
+        /* Один пул к ProxySQL либо по пулу на каждый шард */
+        std::vector<std::unique_ptr<Poco::Data::SessionPool>> pools_;
+        bool direct_shards_;
         std::shared_ptr<search_service::DatabaseConfig> config_;
+        std::unique_ptr<search_service::ReplicaRouter> replicas_;
+        std::atomic<double> pool_wait_ms_;
+        std::atomic<int64_t> pool_wait_updated_;
+        std::atomic<double> pool_wait_max_ms_;
+        std::atomic<uint64_t> failed_checks_;
+        std::atomic<uint64_t> reconnects_;
+
+        std::thread health_thread_;
+        std::mutex health_mtx_;
+        std::condition_variable health_cv_;
+        bool stopping_;
     };
 
 } // namespace database
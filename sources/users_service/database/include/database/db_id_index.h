@@ -0,0 +1,52 @@
+#ifndef SERVER_DB_ID_INDEX_H
+#define SERVER_DB_ID_INDEX_H
+
+#include "database.h"
+
+#include <cstddef>
+
+namespace database {
+
+    /**
+     * @brief Преобразование внешнего id пользователя в пару (шард, id в таблице шарда) и обратно.
+     * @details Внешние id шардов чередуются, поэтому шард определяется по остатку от деления.
+     */
+    class DB_ID_Index {
+        DB_ID_Index() = default;
+    public:
+
+        static DB_ID_Index FromExternID(long id) {
+            DB_ID_Index index{};
+            index.ext_id_ = id;
+            auto max_shards = Database::GetMaxShard();
+
+            index.shard_id_ = (id % max_shards == 0) ? 1 : 0;
+            index.db_id_ = (index.ext_id_ + (max_shards - index.shard_id_ - 1)) / max_shards;
+
+            return index;
+        }
+
+        static DB_ID_Index FromDBID(long id, size_t shard_id) {
+            DB_ID_Index index{};
+            index.db_id_ = id;
+            index.shard_id_ = shard_id;
+
+            auto max_shards = Database::GetMaxShard();
+            index.ext_id_ = max_shards * id - (max_shards - shard_id - 1);
+
+            return index;
+        }
+
+        size_t GetShard() const noexcept { return shard_id_; }
+        long   GetDBID() const noexcept { return db_id_; }
+        long   GetExternalID() const noexcept { return ext_id_;  }
+
+    private:
+        size_t shard_id_;
+        long db_id_;
+        long ext_id_;
+    };
+
+} // namespace database
+
+#endif //SERVER_DB_ID_INDEX_H
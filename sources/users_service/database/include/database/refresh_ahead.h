@@ -0,0 +1,78 @@
+#ifndef SEARCH_SERVICE_REFRESH_AHEAD_H
+#define SEARCH_SERVICE_REFRESH_AHEAD_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace database {
+
+    /**
+     * @brief Упреждающее обновление горячих записей кэша пользователей.
+     * @details Для каждого id считаются обращения к кэшу с момента последней записи в него.
+     * Если запись набрала min_hits обращений и до её истечения осталось меньше ahead_sec,
+     * id ставится в ограниченную очередь, и фоновый поток перечитывает пользователя из БД
+     * и кладёт его в кэш заново. Популярные профили не доходят до промаха, который
+     * оплачивает запрос клиента. Переполненная очередь новые id не принимает.
+     */
+    class RefreshAhead {
+        RefreshAhead();
+
+    public:
+        static RefreshAhead& Instance();
+
+        ~RefreshAhead();
+
+        /* ahead_sec = 0 выключает обновление, max_tracked ограничивает число отслеживаемых id */
+        void Configure(unsigned int ahead_sec, unsigned int min_hits, unsigned int queue_size, unsigned int max_tracked);
+        void Start();
+        void Stop();
+
+        /* Запись положена в хранилище кэша со сроком expiration_sec */
+        void NoteStored(long id, unsigned int expiration_sec);
+
+        /* Запись прочитана из кэша. Для id, запись которого сделал другой экземпляр,
+         * срок неизвестен и считается полным expiration_sec от первого обращения. */
+        void NoteHit(long id, unsigned int expiration_sec);
+
+        /* Запись изменена или удалена - обновлять её из БД больше не нужно */
+        void Forget(long id);
+        void ForgetAll();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Stats {
+            unsigned int hits;
+            Clock::time_point expires_at;
+            bool queued;
+        };
+
+        /* Вызывается под mtx_. Новый id получает срок now + expiration_sec,
+         * nullptr - таблица заполнена и id не отслеживается */
+        Stats* Track(long id, Clock::time_point now, unsigned int expiration_sec);
+
+        void Run();
+        void Refresh(long id);
+
+    private:
+        std::chrono::seconds ahead_;
+        unsigned int min_hits_;
+        size_t queue_size_;
+        size_t max_tracked_;
+        std::atomic<bool> running_;
+
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::unordered_map<long, Stats> stats_;
+        std::deque<long> queue_;
+        std::thread worker_;
+    };
+
+} // namespace database
+
+#endif // SEARCH_SERVICE_REFRESH_AHEAD_H
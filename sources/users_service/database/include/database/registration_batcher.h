@@ -0,0 +1,72 @@
+#ifndef SEARCH_SERVICE_REGISTRATION_BATCHER_H
+#define SEARCH_SERVICE_REGISTRATION_BATCHER_H
+
+#include "user.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace database {
+
+    /**
+     * @brief Групповая запись регистраций пользователей.
+     * @details Параллельные регистрации копятся по шардам в течение короткого окна и
+     * записываются одним многострочным INSERT: один round trip и одна фиксация транзакции
+     * на всю пачку. Каждый ожидающий запрос получает свой внешний id через future.
+     * При нулевом окне пользователь записывается сразу в потоке вызывающего.
+     */
+    class RegistrationBatcher {
+        RegistrationBatcher();
+
+    public:
+        static RegistrationBatcher& Instance();
+
+        ~RegistrationBatcher();
+
+        void Configure(unsigned int window_ms, unsigned int max_batch_size);
+        void Start();
+        void Stop();
+
+        /* Ошибки записи передаются через future теми же исключениями, что и User::InsertBatch */
+        std::future<long> Submit(User user);
+
+    private:
+        struct Pending {
+            User user;
+            std::promise<long> promise;
+        };
+
+        /* Очередь шарда со своим потоком: пачки разных шардов пишутся параллельно */
+        struct Shard {
+            std::mutex mtx;
+            std::condition_variable cv;
+            std::deque<Pending> pending;
+            std::chrono::steady_clock::time_point deadline;
+            std::thread worker;
+        };
+
+        void Run(Shard& shard);
+        static void Commit(std::vector<Pending>& batch);
+
+        /* Вызывается из catch: одиночная запись получает исключение, пачка - повтор по одной */
+        static bool RetryOneByOne(std::vector<Pending>& batch, const std::exception& e);
+
+    private:
+        std::chrono::milliseconds window_;
+        size_t max_batch_size_;
+        std::atomic<bool> running_;
+
+        std::vector<std::unique_ptr<Shard>> shards_;
+    };
+
+} // namespace database
+
+#endif // SEARCH_SERVICE_REGISTRATION_BATCHER_H
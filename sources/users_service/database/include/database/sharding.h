@@ -0,0 +1,33 @@
+#ifndef SEARCH_SERVICE_SHARDING_H
+#define SEARCH_SERVICE_SHARDING_H
+
+#include <functional>
+#include <string>
+
+namespace database {
+
+    struct ShardingHint {
+        std::string hint;
+        long shard_id;
+    };
+
+    /* Число шардов таблицы пользователей за ProxySQL */
+    constexpr const size_t kUserShards = 2;
+
+    /* Комментарий-подсказка, по которому ProxySQL направляет запрос в шард */
+    inline ShardingHint MakeShardingHint(size_t shard_id) {
+        return ShardingHint{ "-- sharding:" + std::to_string(shard_id), static_cast<long>(shard_id) };
+    }
+
+    /**
+     * @brief Шард пользователя по логину.
+     * @details Общий для сервиса и загрузчика начальных данных: иначе уникальность логина,
+     * которую проверяет индекс внутри шарда, нарушается для загруженных пользователей.
+     */
+    inline ShardingHint LoginShardingHint(const std::string& login) {
+        return MakeShardingHint(std::hash<std::string>{}(login) % kUserShards);
+    }
+
+} // namespace database
+
+#endif // SEARCH_SERVICE_SHARDING_H
@@ -11,8 +11,12 @@
 
 namespace database {
 
+    struct UserSearchResult;
+
     class User {
         friend class Database;
+        friend class MySqlUserStorage;
+        friend class MemoryUserStorage;
     public:
         User() = default;
         User(User&& user) = default;
@@ -46,17 +50,26 @@ namespace database {
         static void Init();
 
         static std::vector<User> ReadAll();
-        static std::vector<User> Search(std::string first_name,std::string last_name);
+        static UserSearchResult Search(std::string first_name, std::string last_name);
         static std::optional<User> SearchByID(long id);
+        static std::optional<User> SearchByIDFromPrimary(long id);
         static std::optional<User> SearchByLogin(std::string login);
         static std::optional<User> ChangeRole(std::string login, UserRole new_role);
         static std::optional<User> AuthUser(std::string login, std::string password);
         static std::optional<User> FromCacheByID(long id);
 
-        void SaveToCache();
+        /* Чтение с первичного сервера после промаха кэша. В кэш запись попадает, только если
+         * за время чтения пользователя не изменили: иначе старая строка пережила бы инвалидацию. */
+        static std::optional<User> SearchByIDToCache(long id);
+
+        /* Удаление записи из кэша и рассылка инвалидации остальным экземплярам */
+        static void InvalidateCache(long id);
 
         void InsertToDatabase();
 
+        /* Запись пользователей одного шарда одним запросом, id проставляются каждому */
+        static void InsertBatch(std::vector<User>& users);
+
         [[nodiscard]] Poco::JSON::Object::Ptr ToJSON() const;
 
         std::string Serialize() const;
@@ -76,6 +89,13 @@ namespace database {
 
     };
 
+    /* Результат поиска по маске во всех шардах */
+    struct UserSearchResult {
+        std::vector<User> users;
+        /* Часть шардов не ответила в срок, и список неполон */
+        bool partial{ false };
+    };
+
 } // namespace database
 
 #endif //SERVER_USER_H
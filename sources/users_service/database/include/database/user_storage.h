@@ -0,0 +1,114 @@
+#ifndef SERVER_USER_STORAGE_H
+#define SERVER_USER_STORAGE_H
+
+#include "user.h"
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace database {
+
+    /**
+     * @brief Хранилище пользователей, на которое опираются статические методы User.
+     * @details Реализация выбирается один раз при старте сервиса, до приема запросов.
+     * Кэш и рассылка инвалидаций остаются в User и не зависят от хранилища.
+     */
+    class UserStorage {
+    public:
+        virtual ~UserStorage() = default;
+
+        static UserStorage& Instance();
+
+        /* Подмена хранилища, по умолчанию используется MySqlUserStorage */
+        static void Use(std::unique_ptr<UserStorage> storage);
+
+        virtual void Init() = 0;
+
+        virtual std::vector<User> ReadAll() = 0;
+        virtual UserSearchResult Search(std::string first_name, std::string last_name) = 0;
+        virtual std::optional<User> SearchByID(long id) = 0;
+        virtual std::optional<User> SearchByLogin(std::string login) = 0;
+
+        /* Чтение без реплик, для записи в кэш в обход отстающей реплики. Без реплик - то же, что SearchByID */
+        virtual std::optional<User> SearchByIDFromPrimary(long id) { return SearchByID(id); }
+
+        virtual std::optional<User> ChangeRole(std::string login, UserRole new_role) = 0;
+        virtual std::optional<User> AuthUser(std::string login, std::string password) = 0;
+
+        /* Пользователи одного шарда, id проставляются каждому. Повтор логина - exceptions::Conflict */
+        virtual void InsertBatch(std::vector<User>& users) = 0;
+    };
+
+    /**
+     * @brief Шардированная MySQL за ProxySQL.
+     * @details Чтения по всем шардам ограничены сроком запроса (AsyncDatabase::ReadLimits).
+     * При partial_search поиск по маске отдает ответ успевших шардов, а не ошибку целиком.
+     */
+    class MySqlUserStorage : public UserStorage {
+    public:
+        explicit MySqlUserStorage(bool partial_search = false);
+
+        void Init() override;
+
+        std::vector<User> ReadAll() override;
+        UserSearchResult Search(std::string first_name, std::string last_name) override;
+        std::optional<User> SearchByID(long id) override;
+        std::optional<User> SearchByLogin(std::string login) override;
+        std::optional<User> ChangeRole(std::string login, UserRole new_role) override;
+        std::optional<User> AuthUser(std::string login, std::string password) override;
+
+        std::optional<User> SearchByIDFromPrimary(long id) override;
+
+        void InsertBatch(std::vector<User>& users) override;
+
+    private:
+        std::optional<User> SelectByID(long id, bool from_primary);
+
+    private:
+        bool partial_search_;
+    };
+
+    /**
+     * @brief Хранилище в памяти процесса для запуска сервиса без БД.
+     * @details Повторяет раскладку MySqlUserStorage: шард выбирается по хэшу логина,
+     * id внутри шарда растут с единицы и переводятся во внешние через DB_ID_Index,
+     * логин уникален. Каждый шард защищен своим shared_mutex, поэтому чтения
+     * разных шардов и параллельные чтения одного шарда не блокируют друг друга.
+     */
+    class MemoryUserStorage : public UserStorage {
+    public:
+        MemoryUserStorage();
+
+        void Init() override;
+
+        std::vector<User> ReadAll() override;
+        UserSearchResult Search(std::string first_name, std::string last_name) override;
+        std::optional<User> SearchByID(long id) override;
+        std::optional<User> SearchByLogin(std::string login) override;
+        std::optional<User> ChangeRole(std::string login, UserRole new_role) override;
+        std::optional<User> AuthUser(std::string login, std::string password) override;
+
+        void InsertBatch(std::vector<User>& users) override;
+
+    private:
+        struct Shard {
+            mutable std::shared_mutex mtx;
+            long next_id{ 1 };
+            std::map<long, User> rows;
+            std::unordered_map<std::string, long> by_login;
+        };
+
+        Shard& ShardOf(const std::string& login);
+
+    private:
+        std::vector<Shard> shards_;
+    };
+
+} // namespace database
+
+#endif //SERVER_USER_STORAGE_H
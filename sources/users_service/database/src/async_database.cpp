@@ -0,0 +1,598 @@
+#include "database/async_database.h"
+
+#include "database/database.h"
+
+#include "../../service/config/server_config.h"
+
+#include "errors.h"
+#include "request_deadline.h"
+
+#include <Poco/Data/MySQL/MySQLException.h>
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+#include <errmsg.h>
+#include <mysql.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace {
+
+    /* Период повторного опроса операций, для которых нельзя дождаться события сокета, мс */
+    constexpr const int kPollIntervalMs = 10;
+
+    /* Период опроса при установке соединения, когда сокет ещё не создан, мс */
+    constexpr const int kConnectPollIntervalMs = 1;
+
+    /* Число последних задержек шарда, по которым оценивается p95 */
+    constexpr const size_t kLatencyWindowSize = 128;
+
+    /* Минимум измерений, после которого запросы к шарду дублируются */
+    constexpr const size_t kHedgeMinSamples = 20;
+
+    /* p95 пересчитывается раз в столько успешных запросов */
+    constexpr const size_t kLatencyRecalcPeriod = 16;
+
+} // namespace [ Constants ]
+
+namespace {
+
+    /**
+     * @brief Подстановка параметров вместо '?' в виде экранированных строковых литералов.
+     */
+    std::string BindParameters(MYSQL* connection, const std::string& query, const std::vector<std::string>& params) {
+        std::string result;
+        result.reserve(query.size());
+
+        size_t param_index = 0;
+        for ( char symbol : query ) {
+            if ( symbol != '?' || param_index >= params.size() ) {
+                result.push_back(symbol);
+                continue;
+            }
+
+            const std::string& param = params[param_index++];
+            std::string escaped(param.size() * 2 + 1, '\0');
+            unsigned long length = mysql_real_escape_string(connection, escaped.data(), param.data(), param.size());
+            escaped.resize(length);
+
+            result.push_back('\'');
+            result += escaped;
+            result.push_back('\'');
+        }
+
+        return result;
+    }
+
+    database::AsyncResult ReadResult(MYSQL_RES* result) {
+        database::AsyncResult rows;
+        if ( result == nullptr ) return rows;
+
+        unsigned int fields = mysql_num_fields(result);
+        while ( MYSQL_ROW row = mysql_fetch_row(result) ) {
+            unsigned long* lengths = mysql_fetch_lengths(result);
+
+            database::AsyncRow values;
+            values.reserve(fields);
+            for ( unsigned int i = 0; i < fields; i++ ) {
+                if ( row[i] == nullptr ) {
+                    values.emplace_back(std::nullopt);
+                } else {
+                    values.emplace_back(std::string(row[i], lengths[i]));
+                }
+            }
+            rows.push_back(std::move(values));
+        }
+
+        mysql_free_result(result);
+        return rows;
+    }
+
+    size_t ShardIndex(long shard_id, size_t shards) {
+        if ( shard_id < 0 || shards == 0 ) return 0;
+        return static_cast<size_t>(shard_id) % shards;
+    }
+
+} // namespace [ Functions ]
+
+namespace database {
+
+    struct AsyncDatabase::Operation {
+        enum class Stage {
+            Connect,
+            Query,
+            Store
+        };
+
+        std::string query;
+        std::vector<std::string> params;
+        Callback callback;
+        size_t endpoint{ 0 };
+        size_t primary_endpoint{ 0 };
+        std::optional<size_t> replica;
+
+        MYSQL* connection{ nullptr };
+        Stage stage{ Stage::Query };
+        std::string statement;
+
+        long shard_id{ kDefaultShard };
+        Clock::time_point submitted;
+        std::optional<Clock::time_point> deadline;
+        std::shared_ptr<Hedge> hedge;
+    };
+
+    /**
+     * Общее состояние запроса и его копии на другом адресе шарда. Используется
+     * только потоком событийного цикла: отвечает первая успешная копия, ошибка
+     * передается, только если других копий не осталось.
+     */
+    struct AsyncDatabase::Hedge {
+        unsigned int pending{ 1 };
+        bool started{ false };
+        bool done{ false };
+    };
+
+    AsyncDatabase::AsyncDatabase() :
+        max_connections_(1),
+        running_(false),
+        wake_fd_(-1),
+        primary_endpoints_(1) { /* Empty */ }
+
+    AsyncDatabase& AsyncDatabase::Instance() {
+        static AsyncDatabase instance;
+        return instance;
+    }
+
+    AsyncDatabase::~AsyncDatabase() {
+        Stop();
+    }
+
+    void AsyncDatabase::BindConfigure(std::shared_ptr<search_service::DatabaseConfig> config) {
+        config_ = std::move(config);
+    }
+
+    void AsyncDatabase::Start() {
+        if ( running_ ) return;
+
+        login_ = config_->GetLogin();
+        password_ = config_->GetPassword();
+        database_ = config_->GetDatabase();
+        max_connections_ = std::max(1u, config_->GetAsyncConnections());
+
+        endpoints_.clear();
+        if ( config_->GetDirectShards() && config_->GetShards().size() == Database::GetMaxShard() ) {
+            for ( const auto& shard : config_->GetShards() ) {
+                endpoints_.push_back({ shard.host, shard.port, {}, 0 });
+            }
+        } else {
+            endpoints_.push_back({ config_->GetHost(), config_->GetPort(), {}, 0 });
+        }
+
+        primary_endpoints_ = endpoints_.size();
+        for ( const auto& replica : config_->GetReplicas() ) {
+            endpoints_.push_back({ replica.host, replica.port, {}, 0 });
+        }
+
+        shard_latency_.assign(Database::GetMaxShard(), LatencyWindow{});
+
+        wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if ( wake_fd_ < 0 ) {
+            throw Poco::Data::MySQL::ConnectionException("Failed to create async database wake descriptor");
+        }
+
+        running_ = true;
+        thread_ = std::thread([this]() { Run(); });
+    }
+
+    void AsyncDatabase::Stop() {
+        if ( !running_.exchange(false) ) return;
+
+        Wake();
+        if ( thread_.joinable() ) thread_.join();
+
+        ::close(wake_fd_);
+        wake_fd_ = -1;
+    }
+
+    AsyncDatabase::Limits AsyncDatabase::ReadLimits() const {
+        Limits limits;
+        limits.deadline = search_service::RequestDeadline::Within(config_ ? config_->GetQueryTimeoutMs() : 0);
+        limits.hedge = config_ && config_->GetHedgeReads();
+        return limits;
+    }
+
+    void AsyncDatabase::Execute(std::string query, std::vector<std::string> params, Callback callback,
+                                long shard_id, Route route, Limits limits) {
+        if ( !running_ ) {
+            callback({}, std::make_exception_ptr(
+                    Poco::Data::MySQL::ConnectionException("Async database is not started")));
+            return;
+        }
+
+        auto operation = std::make_unique<Operation>();
+        operation->query = std::move(query);
+        operation->params = std::move(params);
+        operation->callback = std::move(callback);
+        operation->shard_id = shard_id;
+        operation->submitted = Clock::now();
+        operation->deadline = limits.deadline;
+        if ( limits.hedge ) {
+            operation->hedge = std::make_shared<Hedge>();
+        }
+        if ( shard_id != kDefaultShard ) {
+            operation->primary_endpoint = static_cast<size_t>(shard_id) % primary_endpoints_;
+        }
+        operation->endpoint = operation->primary_endpoint;
+
+        if ( route == Route::Replica ) {
+            operation->replica = Database::Instance().PickReplica(shard_id == kDefaultShard ? 0 : shard_id);
+            if ( operation->replica ) {
+                operation->endpoint = primary_endpoints_ + *operation->replica;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lck(submitted_mtx_);
+            submitted_.push_back(std::move(operation));
+        }
+        Wake();
+    }
+
+    std::future<AsyncResult> AsyncDatabase::Query(std::string query, std::vector<std::string> params,
+                                                  long shard_id, Route route, Limits limits) {
+        auto promise = std::make_shared<std::promise<AsyncResult>>();
+        std::future<AsyncResult> future = promise->get_future();
+
+        Execute(std::move(query), std::move(params), [promise](AsyncResult result, std::exception_ptr error) {
+            if ( error ) {
+                promise->set_exception(error);
+            } else {
+                promise->set_value(std::move(result));
+            }
+        }, shard_id, route, limits);
+
+        return future;
+    }
+
+#ifdef SEARCH_SERVICE_COROUTINES
+    AsyncDatabase::QueryAwaitable::QueryAwaitable(AsyncDatabase& database, std::string query,
+                                                  std::vector<std::string> params, long shard_id) :
+        database_(database),
+        query_(std::move(query)),
+        params_(std::move(params)),
+        shard_id_(shard_id) { /* Empty */ }
+
+    void AsyncDatabase::QueryAwaitable::await_suspend(std::coroutine_handle<> handle) {
+        database_.Execute(std::move(query_), std::move(params_), [this, handle](AsyncResult result, std::exception_ptr error) {
+            result_ = std::move(result);
+            error_ = error;
+            handle.resume();
+        }, shard_id_);
+    }
+
+    AsyncResult AsyncDatabase::QueryAwaitable::await_resume() {
+        if ( error_ ) std::rethrow_exception(error_);
+        return std::move(result_);
+    }
+
+    AsyncDatabase::QueryAwaitable AsyncDatabase::QueryAwait(std::string query, std::vector<std::string> params, long shard_id) {
+        return QueryAwaitable(*this, std::move(query), std::move(params), shard_id);
+    }
+#endif
+
+    void AsyncDatabase::Run() {
+        mysql_thread_init();
+
+        while ( running_ ) {
+            Expire();
+            Admit();
+
+            /* Освободившиеся соединения сразу отдаются ожидающим запросам, без ожидания в poll */
+            bool finished = false;
+            for ( size_t i = 0; i < active_.size(); ) {
+                if ( Advance(*active_[i]) ) {
+                    active_[i] = std::move(active_.back());
+                    active_.pop_back();
+                    finished = true;
+                } else {
+                    i++;
+                }
+            }
+
+            std::vector<pollfd> fds;
+            fds.push_back({ wake_fd_, POLLIN, 0 });
+
+            int timeout = finished ? 0 : kPollIntervalMs;
+            for ( const auto& operation : active_ ) {
+                if ( operation->stage == Operation::Stage::Connect ) {
+                    timeout = std::min(timeout, kConnectPollIntervalMs);
+                    continue;
+                }
+                fds.push_back({ operation->connection->net.fd, POLLIN, 0 });
+            }
+
+            poll(fds.data(), fds.size(), timeout);
+
+            if ( fds[0].revents & POLLIN ) {
+                uint64_t value;
+                [[maybe_unused]] auto read = ::read(wake_fd_, &value, sizeof(value));
+            }
+        }
+
+        std::deque<std::unique_ptr<Operation>> pending;
+        {
+            std::lock_guard<std::mutex> lck(submitted_mtx_);
+            pending.swap(submitted_);
+        }
+
+        auto stopped = std::make_exception_ptr(Poco::Data::MySQL::ConnectionException("Async database stopped"));
+        for ( auto& operation : active_ ) {
+            Release(*operation, false);
+            Finish(*operation, {}, stopped);
+        }
+        for ( auto& operation : pending ) {
+            Finish(*operation, {}, stopped);
+        }
+        active_.clear();
+
+        for ( auto& endpoint : endpoints_ ) {
+            for ( MYSQL* connection : endpoint.idle ) {
+                mysql_close(connection);
+            }
+            endpoint.idle.clear();
+            endpoint.open_connections = 0;
+        }
+
+        mysql_thread_end();
+    }
+
+    void AsyncDatabase::Admit() {
+        std::lock_guard<std::mutex> lck(submitted_mtx_);
+
+        /* Запрос к перегруженному шарду не задерживает запросы к остальным */
+        for ( auto it = submitted_.begin(); it != submitted_.end(); ) {
+            auto& operation = *it;
+            Endpoint& endpoint = endpoints_[operation->endpoint];
+
+            if ( !endpoint.idle.empty() ) {
+                operation->connection = endpoint.idle.back();
+                operation->stage = Operation::Stage::Query;
+                endpoint.idle.pop_back();
+            } else if ( endpoint.open_connections < max_connections_ ) {
+                operation->connection = mysql_init(nullptr);
+                if ( operation->connection == nullptr ) {
+                    return;
+                }
+                operation->stage = Operation::Stage::Connect;
+                endpoint.open_connections++;
+            } else {
+                ++it;
+                continue;
+            }
+
+            active_.push_back(std::move(operation));
+            it = submitted_.erase(it);
+        }
+    }
+
+    /**
+     * @brief Прерывание запросов после срока и дублирование медленных.
+     * @details Просроченный запрос завершается с DeadlineExceeded, его соединение закрывается:
+     * ответ на него уже никому не нужен. Копии, проигравшие дублированному запросу,
+     * прерываются так же. Запрос дольше p95 своего шарда дублируется на другой адрес.
+     */
+    void AsyncDatabase::Expire() {
+        auto now = Clock::now();
+
+        auto abandoned = [now](const Operation& operation) {
+            return (operation.deadline && now >= *operation.deadline) || (operation.hedge && operation.hedge->done);
+        };
+
+        auto slow = [this, now](const Operation& operation) {
+            if ( !operation.hedge || operation.hedge->started ) return false;
+
+            const LatencyWindow& window = shard_latency_[ShardIndex(operation.shard_id, shard_latency_.size())];
+            return window.p95 &&
+                   now - operation.submitted >= std::chrono::duration<double, std::milli>(*window.p95);
+        };
+
+        std::vector<std::unique_ptr<Operation>> expired;
+        std::vector<Operation*> hedged;
+
+        {
+            std::lock_guard<std::mutex> lck(submitted_mtx_);
+            for ( auto it = submitted_.begin(); it != submitted_.end(); ) {
+                if ( abandoned(**it) ) {
+                    expired.push_back(std::move(*it));
+                    it = submitted_.erase(it);
+                    continue;
+                }
+                if ( slow(**it) ) hedged.push_back(it->get());
+                ++it;
+            }
+        }
+
+        for ( size_t i = 0; i < active_.size(); ) {
+            if ( abandoned(*active_[i]) ) {
+                Release(*active_[i], false);
+                expired.push_back(std::move(active_[i]));
+                active_[i] = std::move(active_.back());
+                active_.pop_back();
+                continue;
+            }
+            if ( slow(*active_[i]) ) hedged.push_back(active_[i].get());
+            i++;
+        }
+
+        for ( Operation* operation : hedged ) {
+            StartHedge(*operation);
+        }
+
+        for ( auto& operation : expired ) {
+            Finish(*operation, {}, std::make_exception_ptr(exceptions::DeadlineExceeded("Query deadline exceeded")));
+        }
+    }
+
+    void AsyncDatabase::StartHedge(Operation& operation) {
+        operation.hedge->started = true;
+
+        /* Копия уходит с реплики на основной сервер того же шарда. Запрос, отправленный на основной
+         * сервер, на реплику не дублируется: клиент мог только что писать, а поток событийного
+         * цикла, в отличие от потока запроса, этого не знает (ReadYourWrites). */
+        if ( !operation.replica ) return;
+
+        auto copy = std::make_unique<Operation>();
+        copy->primary_endpoint = operation.primary_endpoint;
+        copy->endpoint = operation.primary_endpoint;
+
+        copy->query = operation.query;
+        copy->params = operation.params;
+        copy->callback = operation.callback;
+        copy->shard_id = operation.shard_id;
+        copy->submitted = operation.submitted;
+        copy->deadline = operation.deadline;
+        copy->hedge = operation.hedge;
+        operation.hedge->pending++;
+
+        std::lock_guard<std::mutex> lck(submitted_mtx_);
+        submitted_.push_back(std::move(copy));
+    }
+
+    void AsyncDatabase::RecordLatency(const Operation& operation) {
+        if ( shard_latency_.empty() ) return;
+
+        LatencyWindow& window = shard_latency_[ShardIndex(operation.shard_id, shard_latency_.size())];
+        double elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - operation.submitted).count();
+
+        if ( window.samples.size() < kLatencyWindowSize ) {
+            window.samples.push_back(elapsed_ms);
+        } else {
+            window.samples[window.next] = elapsed_ms;
+            window.next = (window.next + 1) % kLatencyWindowSize;
+        }
+
+        window.recorded++;
+        if ( window.samples.size() >= kHedgeMinSamples && window.recorded % kLatencyRecalcPeriod == 0 ) {
+            std::vector<double> sorted = window.samples;
+            auto p95 = std::next(sorted.begin(), static_cast<std::ptrdiff_t>(sorted.size() * 95 / 100));
+            std::nth_element(sorted.begin(), p95, sorted.end());
+            window.p95 = *p95;
+        }
+    }
+
+    bool AsyncDatabase::Advance(Operation& operation) {
+        MYSQL* connection = operation.connection;
+
+        if ( operation.stage == Operation::Stage::Connect ) {
+            const Endpoint& endpoint = endpoints_[operation.endpoint];
+            net_async_status status = mysql_real_connect_nonblocking(
+                    connection, endpoint.host.c_str(), login_.c_str(), password_.c_str(), database_.c_str(),
+                    endpoint.port, nullptr, 0);
+
+            if ( status == NET_ASYNC_NOT_READY ) return false;
+            if ( status == NET_ASYNC_ERROR ) {
+                std::string error = mysql_error(connection);
+                std::cout << "async connection:" << error << std::endl;
+                Release(operation, false);
+
+                /* Недоступная реплика выводится из ротации, запрос повторяется на основном сервере */
+                if ( operation.replica ) {
+                    Database::Instance().MarkReplicaFailed(*operation.replica);
+                    operation.replica.reset();
+                    operation.endpoint = operation.primary_endpoint;
+                    operation.connection = nullptr;
+
+                    std::lock_guard<std::mutex> lck(submitted_mtx_);
+                    submitted_.push_front(std::make_unique<Operation>(std::move(operation)));
+                    return true;
+                }
+
+                Finish(operation, {}, std::make_exception_ptr(Poco::Data::MySQL::ConnectionException(error)));
+                return true;
+            }
+
+            operation.stage = Operation::Stage::Query;
+        }
+
+        if ( operation.stage == Operation::Stage::Query ) {
+            if ( operation.statement.empty() ) {
+                operation.statement = BindParameters(connection, operation.query, operation.params);
+            }
+
+            net_async_status status = mysql_real_query_nonblocking(
+                    connection, operation.statement.data(), operation.statement.size());
+
+            if ( status == NET_ASYNC_NOT_READY ) return false;
+            if ( status == NET_ASYNC_ERROR ) {
+                std::string error = mysql_error(connection);
+                std::cout << "async statement:" << error << std::endl;
+                Release(operation, mysql_errno(connection) < CR_MIN_ERROR);
+                Finish(operation, {}, std::make_exception_ptr(Poco::Data::MySQL::StatementException(error)));
+                return true;
+            }
+
+            operation.stage = Operation::Stage::Store;
+        }
+
+        MYSQL_RES* result = nullptr;
+        net_async_status status = mysql_store_result_nonblocking(connection, &result);
+
+        if ( status == NET_ASYNC_NOT_READY ) return false;
+        if ( status == NET_ASYNC_ERROR ) {
+            std::string error = mysql_error(connection);
+            std::cout << "async statement:" << error << std::endl;
+            Release(operation, false);
+            Finish(operation, {}, std::make_exception_ptr(Poco::Data::MySQL::StatementException(error)));
+            return true;
+        }
+
+        AsyncResult rows = ReadResult(result);
+        Release(operation, true);
+        Finish(operation, std::move(rows), nullptr);
+        return true;
+    }
+
+    void AsyncDatabase::Finish(Operation& operation, AsyncResult result, std::exception_ptr error) {
+        if ( operation.hedge ) {
+            Hedge& hedge = *operation.hedge;
+            hedge.pending--;
+            if ( hedge.done || (error && hedge.pending > 0) ) {
+                operation.connection = nullptr;
+                return;
+            }
+            hedge.done = true;
+        }
+
+        if ( !error && operation.hedge ) RecordLatency(operation);
+
+        try {
+            operation.callback(std::move(result), error);
+        } catch ( const std::exception& e ) {
+            std::cerr << "Async database callback exception: " << e.what() << std::endl;
+        }
+        operation.connection = nullptr;
+    }
+
+    void AsyncDatabase::Release(Operation& operation, bool reusable) {
+        MYSQL* connection = operation.connection;
+        if ( connection == nullptr ) return;
+
+        Endpoint& endpoint = endpoints_[operation.endpoint];
+        if ( reusable ) {
+            endpoint.idle.push_back(connection);
+            return;
+        }
+
+        mysql_close(connection);
+        endpoint.open_connections--;
+    }
+
+    void AsyncDatabase::Wake() noexcept {
+        uint64_t one = 1;
+        [[maybe_unused]] auto written = ::write(wake_fd_, &one, sizeof(one));
+    }
+
+} // namespace database
@@ -1,10 +1,56 @@
 #include "../include/database/cache.h"
+#include "../include/database/refresh_ahead.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <exception>
+#include <fstream>
+#include <iterator>
 #include <mutex>
+#include <sstream>
+#include <tuple>
+#include <vector>
 
-#include <redis-cpp/stream.h>
-#include <redis-cpp/execute.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+    /* Снимок: заголовок (метка, версия, число записей, время записи),
+     * затем записи (id, длина, сериализованный User). Порядок байт - родной для машины. */
+    constexpr const char kSnapshotMagic[4] = { 'U', 'C', 'S', 'N' };
+    constexpr const uint32_t kSnapshotVersion = 1;
+
+    struct SnapshotHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t count;
+        int64_t saved_at;
+    };
+
+    int64_t WallClockSeconds() {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    template <typename T>
+    void WriteRaw(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    bool ReadRaw(const char*& data, const char* end, T& value) {
+        if ( static_cast<size_t>(end - data) < sizeof(value) ) return false;
+        std::memcpy(&value, data, sizeof(value));
+        data += sizeof(value);
+        return true;
+    }
+
+} // namespace [ Snapshot ]
 
 namespace {
 
@@ -47,19 +93,25 @@ namespace {
 
 namespace database
 {
-    std::mutex _mtx;
-    Cache::Cache() : _expiration(std::make_shared<std::string>("60")), _is_inited(false) {}
+    Cache::Cache() :
+        _expiration(60),
+        _is_inited(false),
+        _local_expiration(30),
+        _local_max_entries(10000) {}
 
-    void Cache::Init(const std::string& server_ip, unsigned int port, unsigned int expiration) {
-        std::lock_guard<std::mutex> lck(_mtx);
+    void Cache::Init(std::unique_ptr<search_service::CacheBackend> backend, unsigned int expiration,
+                     unsigned int local_expiration, unsigned int local_max_entries) {
+        _backend = std::move(backend);
+        _expiration = expiration;
 
-        std::cout << "cache host:" << server_ip <<" port:" << port << std::endl;
-        _stream = rediscpp::make_stream(server_ip, std::to_string(port));
-        if (!_stream->good()) {
-            std::cerr << "Error opening stream." << std::endl;
+        {
+            std::lock_guard<std::mutex> local_lck(_local_mtx);
+            _local.clear();
+            _local_lru.clear();
+            _local_expiration = std::chrono::seconds(local_expiration);
+            _local_max_entries = local_max_entries;
         }
-        _expiration = std::make_shared<std::string>(std::to_string(expiration));
-        _is_inited = true;
+        _is_inited = _backend != nullptr;
     }
 
     Cache* Cache::Get() {
@@ -69,34 +121,298 @@ namespace database
     }
 
     void Cache::Put([[maybe_unused]] long id, [[maybe_unused]] const User& val) {
-        std::lock_guard<std::mutex> lck(_mtx);
+        if ( !_is_inited ) return;
 
-        assert(_stream != nullptr);
+        Store(id, val);
+    }
+
+    uint64_t Cache::Generation(long id) {
+        size_t stripe = Stripe(id);
+        std::lock_guard<std::mutex> lck(_generation_mtx[stripe]);
+        return _generations[stripe];
+    }
 
+    bool Cache::PutIfGeneration(long id, const User& val, uint64_t generation) {
+        if ( !_is_inited ) return false;
+
+        size_t stripe = Stripe(id);
+        std::lock_guard<std::mutex> lck(_generation_mtx[stripe]);
+        if ( _generations[stripe] != generation ) return false;
+
+        Store(id, val);
+        return true;
+    }
+
+    size_t Cache::Stripe(long id) noexcept {
+        return std::hash<long>{}(id) % kGenerationStripes;
+    }
+
+    void Cache::Store(long id, const User& val) {
         std::string serialized = val.Serialize();
-        rediscpp::value response = rediscpp::execute(*_stream, "set",
-                                                     std::to_string(id),
-                                                     serialized,
-                                                     "ex", "60");
+        _backend->Set(std::to_string(id), serialized, _expiration);
+        PutLocal(id, serialized);
+        RefreshAhead::Instance().NoteStored(id, _expiration);
     }
 
     bool Cache::Get([[maybe_unused]] long id, [[maybe_unused]] User& val) {
-        std::lock_guard<std::mutex> lck(_mtx);
-        assert(_stream != nullptr);
-        rediscpp::value response = rediscpp::execute(*_stream, "get", std::to_string(id));
+        if ( !_is_inited ) return false;
 
-        if (response.is_error_message())
-            return false;
-        if (response.empty())
-            return false;
+        std::string serialized;
+        bool from_local = GetLocal(id, serialized);
+
+        if ( !from_local ) {
+            std::optional<std::string> value = _backend->Get(std::to_string(id));
+            if ( !value.has_value() || value->empty() )
+                return false;
+
+            serialized = std::move(*value);
+        }
 
         try {
-            auto serialized = response.as<std::string>();
             val.Deserialize(serialized);
         } catch ( const std::exception& e ) {
+            Invalidate(id);
             return false;
         }
 
+        if ( !from_local ) PutLocal(id, serialized);
+        RefreshAhead::Instance().NoteHit(id, _expiration);
+        return true;
+    }
+
+    void Cache::Remove(long id) {
+        Invalidate(id);
+
+        if ( !_is_inited ) return;
+        _backend->Remove(std::to_string(id));
+    }
+
+    void Cache::Invalidate(long id) {
+        {
+            /* Запись, начатая до инвалидации, либо уже завершена, либо увидит новое поколение */
+            size_t stripe = Stripe(id);
+            std::lock_guard<std::mutex> lck(_generation_mtx[stripe]);
+            _generations[stripe]++;
+        }
+        RefreshAhead::Instance().Forget(id);
+
+        std::lock_guard<std::mutex> lck(_local_mtx);
+        auto it = _local.find(id);
+        if ( it == _local.end() ) return;
+
+        _local_lru.erase(it->second.lru);
+        _local.erase(it);
+    }
+
+    void Cache::InvalidateAll() {
+        for ( size_t stripe = 0; stripe < kGenerationStripes; stripe++ ) {
+            std::lock_guard<std::mutex> lck(_generation_mtx[stripe]);
+            _generations[stripe]++;
+        }
+        RefreshAhead::Instance().ForgetAll();
+
+        std::lock_guard<std::mutex> lck(_local_mtx);
+        _local.clear();
+        _local_lru.clear();
+    }
+
+    size_t Cache::SaveSnapshot(const std::string& path, size_t max_entries) {
+        if ( !_is_inited || max_entries == 0 ) return 0;
+
+        std::vector<std::tuple<unsigned int, long, std::string>> hot;
+        {
+            std::lock_guard<std::mutex> lck(_local_mtx);
+            auto now = Clock::now();
+            hot.reserve(_local.size());
+            for ( const auto& [id, entry] : _local ) {
+                if ( entry.expires_at > now ) hot.emplace_back(entry.hits, id, entry.serialized);
+            }
+        }
+
+        size_t count = std::min(max_entries, hot.size());
+        std::partial_sort(hot.begin(), hot.begin() + static_cast<std::ptrdiff_t>(count), hot.end(),
+                          [](const auto& lhs, const auto& rhs) { return std::get<0>(lhs) > std::get<0>(rhs); });
+
+        /* Запись во временный файл и переименование: оборванная запись не портит прежний снимок */
+        std::string tmp_path = path + ".tmp";
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            if ( !out ) {
+                std::cerr << "Cache snapshot error: cannot open " << tmp_path << std::endl;
+                return 0;
+            }
+
+            SnapshotHeader header{ { }, kSnapshotVersion, static_cast<uint32_t>(count), WallClockSeconds() };
+            std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+            WriteRaw(out, header);
+
+            for ( size_t i = 0; i < count; i++ ) {
+                const auto& [hits, id, serialized] = hot[i];
+                WriteRaw(out, static_cast<int64_t>(id));
+                WriteRaw(out, static_cast<uint32_t>(serialized.size()));
+                out.write(serialized.data(), static_cast<std::streamsize>(serialized.size()));
+            }
+
+            if ( !out.flush() ) {
+                std::cerr << "Cache snapshot error: cannot write " << tmp_path << std::endl;
+                std::remove(tmp_path.c_str());
+                return 0;
+            }
+        }
+
+        if ( std::rename(tmp_path.c_str(), path.c_str()) != 0 ) {
+            std::cerr << "Cache snapshot error: cannot replace " << path << std::endl;
+            std::remove(tmp_path.c_str());
+            return 0;
+        }
+
+        std::cout << "Cache snapshot saved: " << count << " entries to " << path << std::endl;
+        return count;
+    }
+
+    std::future<size_t> Cache::LoadSnapshot(const std::string& path, bool use_mmap) {
+        return std::async(std::launch::async, [this, path, use_mmap]() -> size_t {
+            if ( !_is_inited ) return 0;
+
+            if ( !use_mmap ) {
+                std::ifstream in(path, std::ios::binary);
+                if ( !in ) return 0;
+
+                std::stringstream content;
+                content << in.rdbuf();
+                std::string data = content.str();
+                return RestoreSnapshot(data.data(), data.size());
+            }
+
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if ( fd < 0 ) return 0;
+
+            struct stat st{ };
+            if ( ::fstat(fd, &st) != 0 || st.st_size <= 0 ) {
+                ::close(fd);
+                return 0;
+            }
+
+            auto size = static_cast<size_t>(st.st_size);
+            void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if ( mapped == MAP_FAILED ) {
+                std::cerr << "Cache snapshot error: cannot map " << path << std::endl;
+                return 0;
+            }
+
+            size_t loaded = RestoreSnapshot(static_cast<const char*>(mapped), size);
+            ::munmap(mapped, size);
+            return loaded;
+        });
+    }
+
+    size_t Cache::RestoreSnapshot(const char* data, size_t size) {
+        const char* end = data + size;
+
+        SnapshotHeader header{ };
+        if ( !ReadRaw(data, end, header) ||
+             std::memcmp(header.magic, kSnapshotMagic, sizeof(header.magic)) != 0 ||
+             header.version != kSnapshotVersion ) {
+            std::cerr << "Cache snapshot error: unknown format" << std::endl;
+            return 0;
+        }
+
+        /* Общее хранилище уже содержит эти записи, а более свежие перезаписывать нельзя.
+         * Инвалидации, разосланные пока экземпляр был остановлен, потеряны, поэтому
+         * снимок принимается только в пределах срока локальной копии, а каждая запись
+         * сверяется с хранилищем, куда изменения доходят через Remove(). */
+        bool shared = _backend->IsShared();
+        int64_t max_age = shared ? _local_expiration.count() : static_cast<int64_t>(_expiration);
+
+        if ( WallClockSeconds() - header.saved_at > max_age ) {
+            std::cout << "Cache snapshot is outdated, skipped" << std::endl;
+            return 0;
+        }
+
+        size_t loaded = 0;
+        for ( uint32_t i = 0; i < header.count; i++ ) {
+            int64_t id = 0;
+            uint32_t length = 0;
+            if ( !ReadRaw(data, end, id) || !ReadRaw(data, end, length) ||
+                 static_cast<size_t>(end - data) < length ) {
+                std::cerr << "Cache snapshot error: truncated after " << loaded << " entries" << std::endl;
+                break;
+            }
+
+            std::string serialized(data, length);
+            data += length;
+
+            /* Битые записи отбрасываются так же, как при чтении из хранилища */
+            try {
+                User user;
+                user.Deserialize(serialized);
+            } catch ( const std::exception& e ) {
+                continue;
+            }
+
+            if ( !shared ) {
+                _backend->Set(std::to_string(id), serialized, _expiration);
+                PutLocal(static_cast<long>(id), serialized);
+                loaded++;
+                continue;
+            }
+
+            /* Снимок задает только набор горячих id, значение берется из хранилища */
+            uint64_t generation = Generation(static_cast<long>(id));
+            std::optional<std::string> current = _backend->Get(std::to_string(id));
+            if ( !current.has_value() || current->empty() ) continue;
+
+            size_t stripe = Stripe(static_cast<long>(id));
+            std::lock_guard<std::mutex> lck(_generation_mtx[stripe]);
+            if ( _generations[stripe] != generation ) continue;
+
+            PutLocal(static_cast<long>(id), *current);
+            loaded++;
+        }
+
+        std::cout << "Cache snapshot loaded: " << loaded << " entries" << std::endl;
+        return loaded;
+    }
+
+    void Cache::PutLocal(long id, const std::string& serialized) {
+        if ( _local_max_entries == 0 ) return;
+
+        std::lock_guard<std::mutex> lck(_local_mtx);
+        auto now = Clock::now();
+
+        /* Счетчик обращений сохраняется при обновлении записи - по нему отбираются записи снимка */
+        auto it = _local.find(id);
+        if ( it != _local.end() ) {
+            it->second.serialized = serialized;
+            it->second.expires_at = now + _local_expiration;
+            _local_lru.splice(_local_lru.begin(), _local_lru, it->second.lru);
+            return;
+        }
+
+        /* При переполнении вытесняется одна давно не читанная запись, горячие остаются */
+        if ( _local.size() >= _local_max_entries ) {
+            _local.erase(_local_lru.back());
+            _local_lru.pop_back();
+        }
+
+        _local_lru.push_front(id);
+        _local.emplace(id, LocalEntry{ serialized, now + _local_expiration, 0, _local_lru.begin() });
+    }
+
+    bool Cache::GetLocal(long id, std::string& serialized) {
+        std::lock_guard<std::mutex> lck(_local_mtx);
+        auto it = _local.find(id);
+        if ( it == _local.end() ) return false;
+
+        if ( it->second.expires_at <= Clock::now() ) {
+            _local_lru.erase(it->second.lru);
+            _local.erase(it);
+            return false;
+        }
+        it->second.hits++;
+        _local_lru.splice(_local_lru.begin(), _local_lru, it->second.lru);
+        serialized = it->second.serialized;
         return true;
     }
-}
\ No newline at end of file
+}
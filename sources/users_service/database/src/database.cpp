@@ -1,19 +1,61 @@
 #include "database/database.h"
 
 #include "../../service/config/server_config.h"
+#include "../../../shared/replica_router.h"
+#include "../../../shared/request_deadline.h"
 
 #include "Poco/Data/Transaction.h"
 #include "Poco/Data/Binding.h"
+#include "Poco/Data/DataException.h"
+#include "Poco/Timestamp.h"
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
 
 using Poco::Data::Keywords::use;
 using Poco::Data::Keywords::into;
 using Poco::Data::Keywords::range;
 
+namespace {
+
+    /* Вес нового измерения в скользящем среднем времени ожидания пула */
+    constexpr const double kPoolWaitSmoothing = 0.1;
+
+    /* Время, после которого измерение ожидания пула считается устаревшим, мкс */
+    constexpr const int64_t kPoolWaitStaleness = 1000000;
+
+    /* Верхняя граница задержки между повторными попытками подключения, мс */
+    constexpr const unsigned int kMaxConnectBackoff = 5000;
+
+    constexpr const char* const kPingRequest = "SELECT 1";
+
+} // namespace [ Constants ]
+
+namespace {
+
+    void Ping(Poco::Data::Session& session) {
+        Poco::Data::Statement ping(session);
+        ping << kPingRequest, Poco::Data::Keywords::now;
+    }
+
+} // namespace [ Functions ]
+
 namespace database{
 
-    Database::Database() : is_connected_(false) {}
+    Database::Database() :
+        is_connected_(false),
+        direct_shards_(false),
+        pool_wait_ms_(0.0),
+        pool_wait_updated_(0),
+        pool_wait_max_ms_(0.0),
+        failed_checks_(0),
+        reconnects_(0),
+        stopping_(false) {}
+
+    Database::~Database() {
+        Shutdown();
+    }
 
     Database& Database::Instance(){
         static Database _instance;
@@ -26,52 +68,296 @@ namespace database{
 
     bool Database::IsConnected() const noexcept { return is_connected_; }
 
+    std::string Database::BuildConnectionString(const std::string& host, unsigned int port) const {
+        std::string connection_string;
+        connection_string += "host=" + host + ";";
+        connection_string += "user=" + config_->GetLogin() + ";";
+        connection_string += "db=" + config_->GetDatabase() + ";";
+        connection_string += "port=" + std::to_string(port) + ";";
+        connection_string += "password=" + config_->GetPassword() + ";";
+        return connection_string;
+    }
+
     bool Database::TryConnect() {
-        try {
-            connection_string_ += "host=" + config_->GetHost() + ";";
-            connection_string_ += "user=" + config_->GetLogin() + ";";
-            connection_string_ += "db=" + config_->GetDatabase() + ";";
-            connection_string_ += "port=" + std::to_string(config_->GetPort()) + ";";
-            connection_string_ += "password=" + config_->GetPassword() + ";";
-
-            std::cout << "Try connect to database. Connection request:\n\t" << connection_string_ << std::endl;
-            Poco::Data::MySQL::Connector::registerConnector();
-            pool_ = std::make_unique<Poco::Data::SessionPool>(Poco::Data::MySQL::Connector::KEY, connection_string_);
-            is_connected_ = true;
-            return true;
-        } catch (...) {
+        /* Строка подключения собирается заново, чтобы повторный вызов не дописывал параметры */
+        connection_string_ = BuildConnectionString(config_->GetHost(), config_->GetPort());
+
+        std::vector<std::string> connection_strings;
+        direct_shards_ = config_->GetDirectShards();
+        if ( direct_shards_ && config_->GetShards().size() != GetMaxShard() ) {
+            std::cout << "Direct shard mode requires " << GetMaxShard() << " shard endpoints, got "
+                      << config_->GetShards().size() << ". Falling back to " << config_->GetHost() << std::endl;
+            direct_shards_ = false;
+        }
+
+        if ( direct_shards_ ) {
+            for ( const auto& shard : config_->GetShards() ) {
+                connection_strings.push_back(BuildConnectionString(shard.host, shard.port));
+            }
+        } else {
+            connection_strings.push_back(connection_string_);
+        }
+
+        for ( const auto& connection_string : connection_strings ) {
+            std::cout << "Try connect to database. Connection request:\n\t" << connection_string << std::endl;
+        }
+        Poco::Data::MySQL::Connector::registerConnector();
+
+        unsigned int min_sessions = config_->GetPoolMinSessions();
+        unsigned int max_sessions = std::max(config_->GetPoolMaxSessions(), std::max(min_sessions, 1u));
+        unsigned int attempts = std::max(config_->GetConnectRetries(), 1u);
+        unsigned int backoff = config_->GetConnectBackoff();
+
+        for ( unsigned int attempt = 1; attempt <= attempts; attempt++ ) {
+            try {
+                std::vector<std::unique_ptr<Poco::Data::SessionPool>> pools;
+                for ( const auto& connection_string : connection_strings ) {
+                    auto pool = std::make_unique<Poco::Data::SessionPool>(
+                            Poco::Data::MySQL::Connector::KEY, connection_string,
+                            static_cast<int>(std::max(min_sessions, 1u)),
+                            static_cast<int>(max_sessions),
+                            static_cast<int>(config_->GetPoolIdleTime()));
+
+                    WarmUp(*pool);
+                    pools.push_back(std::move(pool));
+                }
+
+                pools_ = std::move(pools);
+                is_connected_ = true;
+                std::cout << "Database pools are ready: " << pools_.size() << " x (" << min_sessions
+                          << " warm sessions, " << max_sessions << " max)." << std::endl;
+                break;
+            } catch ( const Poco::Exception& e ) {
+                std::cout << "Database connection attempt " << attempt << "/" << attempts
+                          << " failed: " << e.displayText() << std::endl;
+            } catch ( const std::exception& e ) {
+                std::cout << "Database connection attempt " << attempt << "/" << attempts
+                          << " failed: " << e.what() << std::endl;
+            }
+
+            if ( attempt < attempts ) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(backoff));
+                backoff = std::min(backoff * 2, kMaxConnectBackoff);
+            }
+        }
+
+        if ( !is_connected_ ) {
             return false;
         }
+
+        if ( !config_->GetReplicas().empty() && !replicas_ ) {
+            replicas_ = std::make_unique<search_service::ReplicaRouter>(
+                    config_->GetReplicas(), config_->GetMaxReplicaLag(), config_->GetReadYourWritesWindow());
+            replicas_->Connect([this](const std::string& host, unsigned int port) {
+                                   return BuildConnectionString(host, port);
+                               },
+                               1, static_cast<int>(max_sessions), static_cast<int>(config_->GetPoolIdleTime()));
+            replicas_->Start(config_->GetReplicaCheckInterval());
+        }
+
+        if ( config_->GetHealthCheckInterval() > 0 && !health_thread_.joinable() ) {
+            stopping_ = false;
+            health_thread_ = std::thread([this]() { HealthCheckLoop(); });
+        }
+
+        return true;
+    }
+
+    void Database::Shutdown() {
+        {
+            std::lock_guard<std::mutex> lck(health_mtx_);
+            stopping_ = true;
+        }
+        health_cv_.notify_all();
+
+        if ( health_thread_.joinable() ) {
+            health_thread_.join();
+        }
+
+        if ( replicas_ ) {
+            replicas_->Stop();
+        }
+    }
+
+    void Database::WarmUp(Poco::Data::SessionPool& pool) {
+        /* Сессии удерживаются одновременно, иначе пул будет возвращать одну и ту же */
+        std::vector<Poco::Data::Session> sessions;
+        for ( unsigned int i = 0; i < config_->GetPoolMinSessions(); i++ ) {
+            sessions.emplace_back(pool.get());
+            Ping(sessions.back());
+        }
+    }
+
+    bool Database::CheckPool() {
+        bool healthy = true;
+
+        for ( auto& pool : pools_ ) {
+            try {
+                /* Простаивающие сессии проверяются пулом через isGood(), разорванные удаляются */
+                int purged = pool->purgeDeadSessions();
+                if ( purged > 0 ) {
+                    std::cout << "Database pool: purged " << purged << " dead sessions." << std::endl;
+                }
+
+                std::vector<Poco::Data::Session> sessions;
+                while ( pool->allocated() < static_cast<int>(config_->GetPoolMinSessions()) ) {
+                    sessions.emplace_back(pool->get());
+                    Ping(sessions.back());
+                    reconnects_++;
+                }
+
+                if ( sessions.empty() ) {
+                    Poco::Data::Session session(pool->get());
+                    Ping(session);
+                }
+                continue;
+            } catch ( const Poco::Data::SessionPoolExhaustedException& ) {
+                /* Все сессии заняты запросами, значит соединение с БД работает */
+                continue;
+            } catch ( const Poco::Exception& e ) {
+                std::cout << "Database health check failed: " << e.displayText() << std::endl;
+            } catch ( const std::exception& e ) {
+                std::cout << "Database health check failed: " << e.what() << std::endl;
+            }
+
+            failed_checks_++;
+            healthy = false;
+        }
+
+        return healthy;
+    }
+
+    void Database::HealthCheckLoop() {
+        const auto interval = std::chrono::seconds(config_->GetHealthCheckInterval());
+        unsigned int backoff = config_->GetConnectBackoff();
+        auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(interval);
+
+        std::unique_lock<std::mutex> lck(health_mtx_);
+        while ( !health_cv_.wait_for(lck, delay, [this]() { return stopping_; }) ) {
+            lck.unlock();
+            bool healthy = CheckPool();
+
+            /* Метрики пула за прошедший интервал: максимум ожидания и счетчики сбрасываются */
+            PoolStatistics stats = GetPoolStatistics();
+            std::cout << "Database pool: used " << stats.used << "/" << stats.capacity
+                      << ", allocated " << stats.allocated << ", idle " << stats.idle
+                      << ", wait " << stats.wait_ms << " ms, max wait " << stats.max_wait_ms << " ms"
+                      << ", failed checks " << stats.failed_checks << ", reconnects " << stats.reconnects << std::endl;
+            lck.lock();
+
+            /* После сбоя проверки повторяются чаще, с экспоненциальной задержкой */
+            if ( healthy ) {
+                backoff = config_->GetConnectBackoff();
+                delay = std::chrono::duration_cast<std::chrono::milliseconds>(interval);
+            } else {
+                delay = std::min(std::chrono::milliseconds(backoff),
+                                 std::chrono::duration_cast<std::chrono::milliseconds>(interval));
+                backoff = std::min(backoff * 2, kMaxConnectBackoff);
+            }
+        }
+    }
+
+    Poco::Data::Session Database::CreateSession() {
+        return AcquireSession(*pools_.front());
+    }
+
+    Poco::Data::Session Database::CreateSession(const ShardingHint& hint) {
+        if ( !direct_shards_ ) {
+            return AcquireSession(*pools_.front());
+        }
+        return AcquireSession(*pools_[static_cast<size_t>(hint.shard_id) % pools_.size()]);
+    }
+
+    bool Database::UsesDirectShards() const noexcept { return direct_shards_; }
+
+    Poco::Data::Session Database::CreateReadSession(const ShardingHint& hint) {
+        if ( auto index = PickReplica(hint.shard_id) ) {
+            try {
+                return AcquireSession(replicas_->Pool(*index));
+            } catch ( const Poco::Exception& e ) {
+                std::cout << "Replica session failed, reading from primary: " << e.displayText() << std::endl;
+                replicas_->MarkFailed(*index);
+            }
+        }
+        return CreateSession(hint);
     }
 
-    Poco::Data::Session Database::CreateSession(){
-        return Poco::Data::Session(pool_->get());
+    void Database::NoteWrite() {
+        if ( replicas_ ) replicas_->NoteWrite();
+    }
+
+    std::optional<size_t> Database::PickReplica(long shard_id) {
+        if ( !replicas_ ) return std::nullopt;
+        return replicas_->Pick(shard_id);
+    }
+
+    void Database::MarkReplicaFailed(size_t index) noexcept {
+        if ( replicas_ ) replicas_->MarkFailed(index);
+    }
+
+    Poco::Data::Session Database::AcquireSession(Poco::Data::SessionPool& pool) {
+        search_service::RequestDeadline::Check("database session");
+
+        Poco::Timestamp start;
+        Poco::Data::Session session(pool.get());
+
+        /* После длительного простоя среднее начинается заново, а не с устаревшего значения */
+        int64_t now = Poco::Timestamp().epochMicroseconds();
+        double elapsed_ms = static_cast<double>(start.elapsed()) / 1000.0;
+        double current = pool_wait_ms_.load(std::memory_order_relaxed);
+        if ( now - pool_wait_updated_.load(std::memory_order_relaxed) > kPoolWaitStaleness ) {
+            current = elapsed_ms;
+        }
+        pool_wait_ms_.store(current + kPoolWaitSmoothing * (elapsed_ms - current), std::memory_order_relaxed);
+        pool_wait_updated_.store(now, std::memory_order_relaxed);
+
+        double max_wait = pool_wait_max_ms_.load(std::memory_order_relaxed);
+        while ( elapsed_ms > max_wait &&
+                !pool_wait_max_ms_.compare_exchange_weak(max_wait, elapsed_ms, std::memory_order_relaxed) ) { /* Retry */ }
+
+        /* Срок мог истечь, пока запрос ждал свободную сессию */
+        search_service::RequestDeadline::Check("database query");
+
+        return session;
+    }
+
+    double Database::GetPoolWaitTime() const noexcept {
+        int64_t updated = pool_wait_updated_.load(std::memory_order_relaxed);
+        if ( Poco::Timestamp().epochMicroseconds() - updated > kPoolWaitStaleness ) {
+            return 0.0;
+        }
+        return pool_wait_ms_.load(std::memory_order_relaxed);
+    }
+
+    PoolStatistics Database::GetPoolStatistics() {
+        PoolStatistics statistics{};
+        for ( const auto& pool : pools_ ) {
+            statistics.capacity += pool->capacity();
+            statistics.allocated += pool->allocated();
+            statistics.used += pool->used();
+            statistics.idle += pool->idle();
+        }
+        statistics.wait_ms = GetPoolWaitTime();
+        statistics.max_wait_ms = pool_wait_max_ms_.exchange(0.0, std::memory_order_relaxed);
+        statistics.failed_checks = failed_checks_.exchange(0, std::memory_order_relaxed);
+        statistics.reconnects = reconnects_.exchange(0, std::memory_order_relaxed);
+        return statistics;
     }
 
     size_t Database::GetMaxShard() {
-        return 2;
+        return kUserShards;
     }
 
     std::vector<ShardingHint> Database::GetAllHints() {
         std::vector<ShardingHint> result;
         for ( size_t i = 0; i < GetMaxShard(); i++ ) {
-            ShardingHint hint;
-            hint.hint = "-- sharding:" + std::to_string(i);
-            hint.shard_id = i;
-            result.push_back(hint);
+            result.push_back(MakeShardingHint(i));
         }
         return result;
     }
 
     ShardingHint Database::UserShardingHint(const std::string& login) {
-        const std::string& key = login;
-        size_t shard_num = std::hash<std::string>{}(key) % GetMaxShard();
-
-        ShardingHint result;
-        result.hint = "-- sharding:" + std::to_string(shard_num);
-        result.shard_id = shard_num;
-
-        return result;
+        return LoginShardingHint(login);
     }
 
 }
@@ -0,0 +1,505 @@
+#include "database/user_storage.h"
+
+#include "database/database.h"
+#include "database/db_id_index.h"
+#include "database/async_database.h"
+
+#include <Poco/Any.h>
+#include <Poco/Data/MySQL/Connector.h>
+#include <Poco/Data/MySQL/MySQLException.h>
+#include <Poco/Data/RecordSet.h>
+#include <Poco/Data/SessionFactory.h>
+
+#include <future>
+
+#include "errors.h"
+#include "schema_migrations.h"
+
+using namespace Poco::Data::Keywords;
+using Poco::Data::Session;
+using Poco::Data::Statement;
+
+#define TABLE_NAME "Users"
+#define CREATE_TABLE_REQUEST \
+    "CREATE TABLE IF NOT EXISTS `" TABLE_NAME "` "                  \
+    "(`id` "         "INT "          "NOT NULL " "AUTO_INCREMENT,"  \
+    "`first_name` "  "VARCHAR(256) " "NOT NULL,"                    \
+    "`last_name` "   "VARCHAR(256) " "NOT NULL,"                    \
+    "`middle_name` " "VARCHAR(256) " "NULL,"                        \
+    "`email` "       "VARCHAR(256) " "NOT NULL,"                    \
+    "`gender` "      "VARCHAR(32) "  "NOT NULL,"                    \
+    "`login` "       "VARCHAR(256) " "NOT NULL,"                    \
+    "`password` "    "VARCHAR(256) " "NOT NULL,"                    \
+    "`role`     "    "VARCHAR(32)  " "NOT NULL,"                    \
+    "PRIMARY KEY (`id`), "                                          \
+    "KEY `fn` (`first_name`),"                                      \
+    "KEY `ln` (`last_name`));"
+
+#define SELECT_USER_REQUEST \
+    "SELECT id, first_name, last_name, middle_name, email, gender, login, password, role FROM " \
+    TABLE_NAME
+
+#define SELECT_BY_MASK_REQUEST \
+    "SELECT id, first_name, last_name, middle_name, email, gender, role FROM " \
+    TABLE_NAME \
+    " WHERE first_name LIKE ? and last_name LIKE ?"
+
+#define SELECT_BY_ID_REQUEST \
+    "SELECT id, first_name, last_name, middle_name, email, gender, role FROM " \
+    TABLE_NAME \
+    " WHERE id=?"
+
+#define SELECT_BY_LOGIN_REQUEST \
+    "SELECT id, first_name, last_name, middle_name, email, gender, role FROM " \
+    TABLE_NAME \
+    " WHERE login=?"
+
+#define UPDATE_ROLE_REQUEST     \
+    "UPDATE " TABLE_NAME " "    \
+    "SET role=? "               \
+    "WHERE login=?"
+
+#define SELECT_BY_CREDENTIALS_REQUEST \
+    "SELECT id, first_name, last_name, middle_name, email, gender, role FROM " \
+    TABLE_NAME \
+    " WHERE login=? and password=?"
+
+#define INSERT_USERS_REQUEST \
+    "INSERT INTO " TABLE_NAME " " \
+    "(first_name, last_name, middle_name, email, gender, login, password, role) " \
+    "VALUES"
+
+#define INSERT_USER_VALUES "(?, ?, ?, ?, ?, ?, ?, ?)"
+
+#define SELECT_AUTO_INCREMENT_STEP_REQUEST \
+    "SELECT @@auto_increment_increment"
+
+namespace {
+
+    /* ER_DUP_ENTRY */
+    constexpr const unsigned int kDuplicateEntryError = 1062;
+
+} // namespace [ Constants ]
+
+namespace {
+
+    /**
+     * Индексы и прочие изменения схемы после CREATE TABLE. Уже примененные версии
+     * не выполняются повторно, новые добавляются в конец списка.
+     */
+    const std::vector<search_service::Migration>& UserMigrations() {
+        static const std::vector<search_service::Migration> migrations = {
+            { 1, "unique login for registration and auth queries",
+              { search_service::OnlineAddIndex(TABLE_NAME, "login_uq", "`login`", true) } },
+        };
+        return migrations;
+    }
+
+    /* Шаг AUTO_INCREMENT каждого шарда, читается один раз в Init */
+    std::vector<long> auto_increment_steps;
+
+    /* Старые версии Poco кладут код ошибки MySQL только в текст сообщения */
+    bool IsDuplicateEntry(const Poco::Data::MySQL::StatementException& e) {
+        return e.code() == static_cast<int>(kDuplicateEntryError) ||
+               e.message().find("Duplicate entry") != std::string::npos;
+    }
+
+    /**
+     * @brief Сборка пользователя из строки результата асинхронного запроса.
+     * @details Ожидаемый порядок столбцов: id, first_name, last_name, middle_name, email, gender, role.
+     */
+    database::User UserFromRow(const database::AsyncRow& row, size_t shard_id) {
+        database::User user;
+
+        long db_id = std::stol(row[0].value_or("0"));
+        user.ID()         = database::DB_ID_Index::FromDBID(db_id, shard_id).GetExternalID();
+        user.FirstName()  = row[1].value_or("");
+        user.LastName()   = row[2].value_or("");
+        user.MiddleName() = row[3].value_or("");
+        user.EMail()      = row[4].value_or("");
+        user.Gender()     = row[5].value_or("");
+        user.Role()       = database::UserRole(row[6].value_or(""));
+
+        return user;
+    }
+
+}
+
+namespace database {
+
+    MySqlUserStorage::MySqlUserStorage(bool partial_search) : partial_search_(partial_search) { /* Empty */ }
+
+    void MySqlUserStorage::Init() {
+        try {
+
+            auto hints = database::Database::GetAllHints();
+            auto_increment_steps.assign(hints.size(), 1);
+
+            for ( auto& hint : hints ) {
+                Poco::Data::Session session = database::Database::Instance().CreateSession(hint);
+                Statement create_stmt(session);
+                create_stmt << CREATE_TABLE_REQUEST << " " << hint.hint, now;
+
+                std::cout << "DB create statement send: " <<  create_stmt.toString() << std::endl;
+
+                search_service::MigrationRunner(TABLE_NAME, UserMigrations()).Apply(session, hint.hint);
+
+                Statement step_stmt(session);
+                step_stmt << SELECT_AUTO_INCREMENT_STEP_REQUEST << " " << hint.hint,
+                        into(auto_increment_steps[hint.shard_id]),
+                        now;
+            }
+        }
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cout << "connection:" << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cout << "statement:" << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    std::vector<User> MySqlUserStorage::ReadAll() {
+        try
+        {
+            std::vector<User> result;
+
+            User user;
+
+            for ( const auto& hint : database::Database::GetAllHints() ) {
+                std::string select_str = SELECT_USER_REQUEST + std::string(" ") + hint.hint;
+
+                Poco::Data::Session session = database::Database::Instance().CreateReadSession(hint);
+                Statement select(session);
+
+                std::string role_str;
+                select << select_str, into(user.id_),
+                        into(user.first_name_),
+                        into(user.last_name_),
+                        into(user.middle_name_),
+                        into(user.email_),
+                        into(user.gender_),
+                        into(user.login_),
+                        into(user.password_),
+                        into(role_str),
+                        range(0, 1); //  iterate over result set one row at a time
+
+                while (!select.done()) {
+                    if (select.execute()) {
+                        user.Role() = UserRole(role_str);
+                        result.push_back(user);
+                    }
+                }
+            }
+
+            return result;
+        }
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cout << "connection:" << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cout << "statement:" << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    UserSearchResult MySqlUserStorage::Search(std::string first_name, std::string last_name) {
+        try {
+
+            UserSearchResult result;
+
+            std::vector<ShardingHint> hints = database::Database::GetAllHints();
+            auto limits = database::AsyncDatabase::Instance().ReadLimits();
+
+            std::vector<std::future<AsyncResult>> futures;
+
+            for ( const auto& hint : hints ) {
+                std::string select_req = SELECT_BY_MASK_REQUEST;
+                select_req += " " + hint.hint;
+
+                futures.emplace_back(database::AsyncDatabase::Instance().Query(
+                        select_req, { first_name + "%", last_name + "%" }, hint.shard_id,
+                        database::AsyncDatabase::Route::Replica, limits));
+            }
+
+            /* Шард, не ответивший в срок или с ошибкой, пропускается, если ответил хотя бы один */
+            std::exception_ptr shard_error;
+            size_t answered = 0;
+            for ( size_t i = 0; i < futures.size(); i++ ) {
+                AsyncResult rows;
+                try {
+                    rows = futures[i].get();
+                } catch ( const std::exception& e ) {
+                    if ( !partial_search_ ) throw;
+                    std::cout << "search: shard " << hints[i].shard_id << " skipped: " << e.what() << std::endl;
+                    shard_error = std::current_exception();
+                    continue;
+                }
+
+                answered++;
+                for ( const AsyncRow& row : rows ) {
+                    result.users.push_back(UserFromRow(row, hints[i].shard_id));
+                }
+            }
+
+            if ( answered == 0 && shard_error ) std::rethrow_exception(shard_error);
+            result.partial = answered < futures.size();
+
+            return result;
+        }
+
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cout << "connection:" << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cout << "statement:" << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    std::optional<User> MySqlUserStorage::SearchByID(long id) {
+        return SelectByID(id, false);
+    }
+
+    std::optional<User> MySqlUserStorage::SearchByIDFromPrimary(long id) {
+        return SelectByID(id, true);
+    }
+
+    std::optional<User> MySqlUserStorage::SelectByID(long id, bool from_primary) {
+        try {
+            User info;
+
+            auto id_index = DB_ID_Index::FromExternID(id);
+            auto internal_id = id_index.GetDBID();
+            auto shard_id = id_index.GetShard();
+
+            ShardingHint sharding_hint = database::Database::GetAllHints().at(shard_id);
+            std::string query = SELECT_BY_ID_REQUEST + std::string(" ") + sharding_hint.hint;
+
+            Poco::Data::Session session = from_primary
+                    ? database::Database::Instance().CreateSession(sharding_hint)
+                    : database::Database::Instance().CreateReadSession(sharding_hint);
+            Statement select(session);
+
+            std::string role_str;
+            select << query,
+                    into(info.id_),
+                    into(info.first_name_),
+                    into(info.last_name_),
+                    into(info.middle_name_),
+                    into(info.email_),
+                    into(info.gender_),
+                    into(role_str),
+                    use(internal_id); //  iterate over result set one row at a time
+
+
+            size_t selected_rows = select.execute();
+            if ( selected_rows > 0 ) {
+                info.Role() = UserRole(role_str);
+                info.ID() = id_index.GetExternalID();
+                return info;
+            }
+
+            return { };
+        }
+
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cout << "connection:" << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cout << "statement:" << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    std::optional<User> MySqlUserStorage::SearchByLogin(std::string login) {
+        try {
+            std::vector<ShardingHint> hints = database::Database::GetAllHints();
+            auto limits = database::AsyncDatabase::Instance().ReadLimits();
+
+            std::vector<std::future<AsyncResult>> futures;
+
+            for ( const ShardingHint& hint : hints ) {
+                std::string select_req = SELECT_BY_LOGIN_REQUEST;
+                select_req += " " + hint.hint;
+
+                futures.emplace_back(database::AsyncDatabase::Instance().Query(select_req, { login }, hint.shard_id,
+                                                                               database::AsyncDatabase::Route::Replica, limits));
+            }
+
+            /* Дожидаемся всех шардов, чтобы исключение любого из них не потерялось */
+            std::optional<User> found;
+            for ( size_t i = 0; i < futures.size(); i++ ) {
+                AsyncResult rows = futures[i].get();
+                if ( !found.has_value() && !rows.empty() ) {
+                    found = UserFromRow(rows.front(), hints[i].shard_id);
+                }
+            }
+
+            if ( found.has_value() ) {
+                std::cout << "User with login " << login << " found with ID " << found->GetID() << std::endl;
+                return found;
+            }
+
+            std::cout << "User with login " << login << " not found " << std::endl;
+
+            return { };
+        }
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cout << "connection:" << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cout << "statement:" << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    std::optional<User> MySqlUserStorage::ChangeRole(std::string login, database::UserRole new_role) {
+        try {
+            std::string new_role_str = new_role.ToString();
+            ShardingHint sharding_hint = database::Database::UserShardingHint(login);
+
+            Poco::Data::Session session = database::Database::Instance().CreateSession(sharding_hint);
+            Statement update(session);
+
+            std::string query = UPDATE_ROLE_REQUEST + std::string(" ") + sharding_hint.hint;
+
+            update << query,
+                      use(new_role_str),
+                      use(login);
+
+            size_t updated_rows = update.execute();
+            database::Database::Instance().NoteWrite();
+
+            if ( updated_rows == 0 ) {
+                return { };
+            }
+
+            return SearchByLogin(login);
+        }
+
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cout << "connection:" << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cout << "statement:" << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    std::optional<User> MySqlUserStorage::AuthUser(std::string login, std::string password) {
+        try {
+
+            std::vector<ShardingHint> hints = database::Database::GetAllHints();
+            auto limits = database::AsyncDatabase::Instance().ReadLimits();
+
+            std::vector<std::future<AsyncResult>> futures;
+
+            for ( const ShardingHint& hint : hints ) {
+                std::string select_req = SELECT_BY_CREDENTIALS_REQUEST;
+                select_req += " " + hint.hint;
+
+                futures.emplace_back(database::AsyncDatabase::Instance().Query(select_req, { login, password }, hint.shard_id,
+                                                                               database::AsyncDatabase::Route::Replica, limits));
+            }
+
+            std::optional<User> found;
+            for ( size_t i = 0; i < futures.size(); i++ ) {
+                AsyncResult rows = futures[i].get();
+                if ( !found.has_value() && !rows.empty() ) {
+                    found = UserFromRow(rows.front(), hints[i].shard_id);
+                }
+            }
+
+            return found;
+        }
+
+        catch (Poco::Data::MySQL::ConnectionException &e) {
+            std::cout << "connection:" << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e) {
+            std::cout << "statement:" << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    void MySqlUserStorage::InsertBatch(std::vector<User>& users) {
+        if ( users.empty() ) return;
+
+        try
+        {
+            ShardingHint sharding_hint = database::Database::UserShardingHint(users.front().login_);
+            Poco::Data::Session session = database::Database::Instance().CreateSession(sharding_hint);
+            Poco::Data::Statement insert(session);
+
+            std::string insert_req = INSERT_USERS_REQUEST;
+            for ( size_t i = 0; i < users.size(); i++ ) {
+                insert_req += (i == 0 ? " " : ", ");
+                insert_req += INSERT_USER_VALUES;
+            }
+            insert_req += " " + sharding_hint.hint;
+
+            /* Привязки хранят ссылки, поэтому строки ролей не должны переезжать в памяти */
+            std::vector<std::string> roles;
+            roles.reserve(users.size());
+
+            insert << insert_req;
+            for ( User& user : users ) {
+                roles.push_back(user.role_.ToString());
+                insert, use(user.first_name_),
+                        use(user.last_name_),
+                        use(user.middle_name_),
+                        use(user.email_),
+                        use(user.gender_),
+                        use(user.login_),
+                        use(user.password_),
+                        use(roles.back());
+            }
+
+            size_t changes = 0;
+            try {
+                changes = insert.execute();
+            } catch (Poco::Data::MySQL::StatementException &e) {
+                if ( IsDuplicateEntry(e) ) throw exceptions::Conflict(e.message());
+                throw;
+            }
+            database::Database::Instance().NoteWrite();
+            if ( changes == 0 ) return;
+
+            /**
+             * id первой строки приходит в ответе на INSERT, отдельный SELECT LAST_INSERT_ID() не нужен.
+             * Многострочный INSERT с известным числом строк InnoDB выполняет как простую вставку
+             * и выдает ей идущие подряд значения AUTO_INCREMENT.
+             */
+            long first_id = static_cast<long>(Poco::AnyCast<Poco::UInt64>(session.getProperty("insertId")));
+            long increment = sharding_hint.shard_id < auto_increment_steps.size()
+                             ? auto_increment_steps[sharding_hint.shard_id] : 1;
+
+            for ( size_t i = 0; i < users.size(); i++ ) {
+                long db_id = first_id + static_cast<long>(i) * increment;
+                users[i].id_ = DB_ID_Index::FromDBID(db_id, sharding_hint.shard_id).GetExternalID();
+            }
+            std::cout << "Inserted " << users.size() << " users with shard id " << sharding_hint.shard_id
+                      << " DB IDX from: " << first_id << " External ID from: " << users.front().id_ << std::endl;
+        }
+        catch (Poco::Data::MySQL::ConnectionException &e)
+        {
+            std::cout << "connection:" << e.what() << std::endl;
+            throw;
+        }
+        catch (Poco::Data::MySQL::StatementException &e)
+        {
+
+            std::cout << "statement:" << e.what() << std::endl;
+            throw;
+        }
+    }
+
+} // namespace database
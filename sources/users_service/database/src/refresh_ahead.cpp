@@ -0,0 +1,173 @@
+#include "database/refresh_ahead.h"
+
+#include "database/cache.h"
+#include "database/user.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <optional>
+
+namespace {
+
+    constexpr const unsigned int kDefaultMinHits = 5;
+    constexpr const unsigned int kDefaultQueueSize = 256;
+    constexpr const unsigned int kDefaultMaxTracked = 10000;
+
+} // namespace [ Constants ]
+
+namespace database {
+
+    RefreshAhead::RefreshAhead() :
+        ahead_(0),
+        min_hits_(kDefaultMinHits),
+        queue_size_(kDefaultQueueSize),
+        max_tracked_(kDefaultMaxTracked),
+        running_(false) { /* Empty */ }
+
+    RefreshAhead& RefreshAhead::Instance() {
+        static RefreshAhead instance;
+        return instance;
+    }
+
+    RefreshAhead::~RefreshAhead() {
+        Stop();
+    }
+
+    void RefreshAhead::Configure(unsigned int ahead_sec, unsigned int min_hits, unsigned int queue_size,
+                                 unsigned int max_tracked) {
+        ahead_ = std::chrono::seconds(ahead_sec);
+        min_hits_ = std::max(1u, min_hits);
+        queue_size_ = std::max(1u, queue_size);
+        max_tracked_ = std::max(1u, max_tracked);
+    }
+
+    void RefreshAhead::Start() {
+        if ( ahead_.count() == 0 ) return;
+        if ( running_.exchange(true) ) return;
+
+        worker_ = std::thread([this]() { Run(); });
+    }
+
+    void RefreshAhead::Stop() {
+        if ( !running_.exchange(false) ) return;
+
+        {
+            std::lock_guard<std::mutex> lck(mtx_);
+            queue_.clear();
+        }
+        cv_.notify_all();
+        if ( worker_.joinable() ) worker_.join();
+
+        std::lock_guard<std::mutex> lck(mtx_);
+        stats_.clear();
+    }
+
+    void RefreshAhead::NoteStored(long id, unsigned int expiration_sec) {
+        if ( !running_ ) return;
+
+        std::lock_guard<std::mutex> lck(mtx_);
+        auto now = Clock::now();
+        if ( Stats* stats = Track(id, now, expiration_sec) ) {
+            /* Счет обращений начинается заново: ключ должен оставаться горячим весь новый срок */
+            stats->hits = 0;
+            stats->expires_at = now + std::chrono::seconds(expiration_sec);
+            stats->queued = false;
+        }
+    }
+
+    void RefreshAhead::NoteHit(long id, unsigned int expiration_sec) {
+        if ( !running_ ) return;
+
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> lck(mtx_);
+            auto now = Clock::now();
+            Stats* stats = Track(id, now, expiration_sec);
+            if ( !stats ) return;
+
+            stats->hits++;
+            if ( !stats->queued && stats->hits >= min_hits_ && now + ahead_ >= stats->expires_at &&
+                 queue_.size() < queue_size_ ) {
+                stats->queued = true;
+                queue_.push_back(id);
+                wake = true;
+            }
+        }
+        if ( wake ) cv_.notify_one();
+    }
+
+    void RefreshAhead::Forget(long id) {
+        std::lock_guard<std::mutex> lck(mtx_);
+        stats_.erase(id);
+    }
+
+    void RefreshAhead::ForgetAll() {
+        std::lock_guard<std::mutex> lck(mtx_);
+        stats_.clear();
+    }
+
+    RefreshAhead::Stats* RefreshAhead::Track(long id, Clock::time_point now, unsigned int expiration_sec) {
+        auto it = stats_.find(id);
+        if ( it != stats_.end() ) return &it->second;
+
+        /* Место освобождают истекшие записи, горячие ключи из таблицы не вытесняются */
+        if ( stats_.size() >= max_tracked_ ) {
+            for ( auto stale = stats_.begin(); stale != stats_.end(); ) {
+                bool expired = !stale->second.queued && stale->second.expires_at <= now;
+                stale = expired ? stats_.erase(stale) : std::next(stale);
+            }
+            if ( stats_.size() >= max_tracked_ ) return nullptr;
+        }
+
+        Stats& stats = stats_[id];
+        stats = Stats{ 0, now + std::chrono::seconds(expiration_sec), false };
+        return &stats;
+    }
+
+    void RefreshAhead::Run() {
+        while ( true ) {
+            long id;
+            {
+                std::unique_lock<std::mutex> lck(mtx_);
+                cv_.wait(lck, [this]() { return !running_ || !queue_.empty(); });
+                if ( !running_ ) return;
+
+                id = queue_.front();
+                queue_.pop_front();
+            }
+            Refresh(id);
+        }
+    }
+
+    void RefreshAhead::Refresh(long id) {
+        /* Поколение берется до чтения: изменение пользователя во время чтения отменит запись */
+        uint64_t generation = Cache::Get()->Generation(id);
+
+        /* Реплика может отставать, а запись в кэш живет весь срок хранилища */
+        std::optional<User> user;
+        try {
+            user = User::SearchByIDFromPrimary(id);
+        } catch ( const std::exception& e ) {
+            std::cerr << "Refresh ahead: read of user " << id << " failed: " << e.what() << std::endl;
+        }
+
+        {
+            std::lock_guard<std::mutex> lck(mtx_);
+            auto it = stats_.find(id);
+            if ( it == stats_.end() || !it->second.queued ) return;
+
+            if ( !user.has_value() ) {
+                stats_.erase(it);
+                return;
+            }
+        }
+
+        /* Cache::PutIfGeneration через NoteStored сбрасывает счетчик и снимает отметку очереди */
+        if ( !Cache::Get()->PutIfGeneration(id, *user, generation) ) {
+            Forget(id);
+        }
+    }
+
+} // namespace database
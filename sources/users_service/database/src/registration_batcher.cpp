@@ -0,0 +1,171 @@
+#include "database/registration_batcher.h"
+
+#include "database/database.h"
+
+#include <Poco/Data/MySQL/MySQLException.h>
+
+#include "errors.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+    constexpr const unsigned int kDefaultWindow = 5;
+    constexpr const unsigned int kDefaultMaxBatchSize = 64;
+
+} // namespace [ Constants ]
+
+namespace database {
+
+    RegistrationBatcher::RegistrationBatcher() :
+        window_(kDefaultWindow),
+        max_batch_size_(kDefaultMaxBatchSize),
+        running_(false) { /* Empty */ }
+
+    RegistrationBatcher& RegistrationBatcher::Instance() {
+        static RegistrationBatcher instance;
+        return instance;
+    }
+
+    RegistrationBatcher::~RegistrationBatcher() {
+        Stop();
+    }
+
+    void RegistrationBatcher::Configure(unsigned int window_ms, unsigned int max_batch_size) {
+        window_ = std::chrono::milliseconds(window_ms);
+        max_batch_size_ = std::max(1u, max_batch_size);
+    }
+
+    void RegistrationBatcher::Start() {
+        if ( window_.count() == 0 || max_batch_size_ == 1 ) return;
+        if ( running_.exchange(true) ) return;
+
+        shards_.clear();
+        for ( size_t i = 0; i < Database::GetMaxShard(); i++ ) {
+            shards_.push_back(std::make_unique<Shard>());
+        }
+        for ( auto& shard : shards_ ) {
+            shard->worker = std::thread([this, &shard = *shard]() { Run(shard); });
+        }
+    }
+
+    void RegistrationBatcher::Stop() {
+        if ( !running_.exchange(false) ) return;
+
+        for ( auto& shard : shards_ ) {
+            {
+                std::lock_guard<std::mutex> lck(shard->mtx);
+            }
+            shard->cv.notify_all();
+        }
+        /* Потоки дописывают накопленное перед выходом */
+        for ( auto& shard : shards_ ) {
+            if ( shard->worker.joinable() ) shard->worker.join();
+        }
+    }
+
+    std::future<long> RegistrationBatcher::Submit(User user) {
+        Pending pending{ std::move(user), std::promise<long>() };
+        std::future<long> result = pending.promise.get_future();
+
+        if ( running_ ) {
+            Shard& shard = *shards_[Database::UserShardingHint(pending.user.GetLogin()).shard_id];
+
+            std::unique_lock<std::mutex> lck(shard.mtx);
+            if ( running_ ) {
+                if ( shard.pending.empty() ) {
+                    shard.deadline = std::chrono::steady_clock::now() + window_;
+                }
+                shard.pending.push_back(std::move(pending));
+                bool wake = shard.pending.size() == 1 || shard.pending.size() >= max_batch_size_;
+                lck.unlock();
+
+                if ( wake ) shard.cv.notify_one();
+                return result;
+            }
+        }
+
+        std::vector<Pending> batch;
+        batch.push_back(std::move(pending));
+        Commit(batch);
+        return result;
+    }
+
+    void RegistrationBatcher::Run(Shard& shard) {
+        std::unique_lock<std::mutex> lck(shard.mtx);
+        while ( true ) {
+            shard.cv.wait(lck, [this, &shard]() { return !shard.pending.empty() || !running_; });
+            if ( shard.pending.empty() ) return;
+
+            shard.cv.wait_until(lck, shard.deadline, [this, &shard]() {
+                return shard.pending.size() >= max_batch_size_ || !running_;
+            });
+
+            size_t count = std::min(shard.pending.size(), max_batch_size_);
+            std::vector<Pending> batch;
+            batch.reserve(count);
+            for ( size_t i = 0; i < count; i++ ) {
+                batch.push_back(std::move(shard.pending.front()));
+                shard.pending.pop_front();
+            }
+
+            /* Остаток уже прождал своё окно */
+            shard.deadline = std::chrono::steady_clock::now();
+
+            lck.unlock();
+            Commit(batch);
+            lck.lock();
+        }
+    }
+
+    bool RegistrationBatcher::RetryOneByOne(std::vector<Pending>& batch, const std::exception& e) {
+        if ( batch.size() == 1 ) {
+            batch.front().promise.set_exception(std::current_exception());
+            return false;
+        }
+        std::cerr << "Registration batch of " << batch.size() << " rejected, retrying one by one: "
+                  << e.what() << std::endl;
+        return true;
+    }
+
+    void RegistrationBatcher::Commit(std::vector<Pending>& batch) {
+        std::vector<User> users;
+        users.reserve(batch.size());
+        for ( auto& pending : batch ) {
+            users.push_back(pending.user);
+        }
+
+        try {
+            User::InsertBatch(users);
+            for ( size_t i = 0; i < batch.size(); i++ ) {
+                batch[i].promise.set_value(users[i].GetID());
+            }
+            return;
+        }
+        catch (const exceptions::Conflict& e) {
+            if ( !RetryOneByOne(batch, e) ) return;
+        }
+        catch (const Poco::Data::MySQL::StatementException& e) {
+            if ( !RetryOneByOne(batch, e) ) return;
+        }
+        catch (...) {
+            for ( auto& pending : batch ) {
+                pending.promise.set_exception(std::current_exception());
+            }
+            return;
+        }
+
+        /* Многострочный INSERT атомарен: строки не записаны, виновника ищем по одной */
+        for ( auto& pending : batch ) {
+            try {
+                std::vector<User> single{ pending.user };
+                User::InsertBatch(single);
+                pending.promise.set_value(single.front().GetID());
+            } catch (...) {
+                pending.promise.set_exception(std::current_exception());
+            }
+        }
+    }
+
+} // namespace database
@@ -0,0 +1,158 @@
+#include "database/user_storage.h"
+
+#include "database/database.h"
+#include "database/db_id_index.h"
+
+#include <cctype>
+#include <iostream>
+#include <mutex>
+#include <unordered_set>
+
+#include "errors.h"
+
+namespace {
+
+    std::unique_ptr<database::UserStorage>& CurrentStorage() {
+        static std::unique_ptr<database::UserStorage> storage = std::make_unique<database::MySqlUserStorage>();
+        return storage;
+    }
+
+    /* Аналог `column LIKE 'prefix%'` при регистронезависимой сортировке MySQL */
+    bool StartsWith(const std::string& value, const std::string& prefix) {
+        if ( value.size() < prefix.size() ) return false;
+        for ( size_t i = 0; i < prefix.size(); i++ ) {
+            if ( std::tolower(static_cast<unsigned char>(value[i])) !=
+                 std::tolower(static_cast<unsigned char>(prefix[i])) ) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /* Поиск в MySQL не выбирает логин и пароль, в памяти они так же не отдаются */
+    database::User WithoutCredentials(database::User user) {
+        user.Login().clear();
+        user.Password().clear();
+        return user;
+    }
+
+} // namespace [ Functions ]
+
+namespace database {
+
+    UserStorage& UserStorage::Instance() {
+        return *CurrentStorage();
+    }
+
+    void UserStorage::Use(std::unique_ptr<UserStorage> storage) {
+        CurrentStorage() = std::move(storage);
+    }
+
+    MemoryUserStorage::MemoryUserStorage() : shards_(Database::GetMaxShard()) {}
+
+    void MemoryUserStorage::Init() {
+        std::cout << "Users are kept in memory, shards: " << shards_.size() << std::endl;
+    }
+
+    std::vector<User> MemoryUserStorage::ReadAll() {
+        std::vector<User> result;
+        for ( const Shard& shard : shards_ ) {
+            std::shared_lock<std::shared_mutex> lck(shard.mtx);
+            for ( const auto& row : shard.rows ) {
+                result.push_back(row.second);
+            }
+        }
+        return result;
+    }
+
+    UserSearchResult MemoryUserStorage::Search(std::string first_name, std::string last_name) {
+        UserSearchResult result;
+        for ( const Shard& shard : shards_ ) {
+            std::shared_lock<std::shared_mutex> lck(shard.mtx);
+            for ( const auto& row : shard.rows ) {
+                const User& user = row.second;
+                if ( StartsWith(user.first_name_, first_name) && StartsWith(user.last_name_, last_name) ) {
+                    result.users.push_back(WithoutCredentials(user));
+                }
+            }
+        }
+        return result;
+    }
+
+    std::optional<User> MemoryUserStorage::SearchByID(long id) {
+        if ( id <= 0 ) return { };
+
+        auto id_index = DB_ID_Index::FromExternID(id);
+        const Shard& shard = shards_.at(id_index.GetShard());
+
+        std::shared_lock<std::shared_mutex> lck(shard.mtx);
+        auto it = shard.rows.find(id_index.GetDBID());
+        if ( it == shard.rows.end() ) return { };
+
+        return WithoutCredentials(it->second);
+    }
+
+    std::optional<User> MemoryUserStorage::SearchByLogin(std::string login) {
+        const Shard& shard = ShardOf(login);
+
+        std::shared_lock<std::shared_mutex> lck(shard.mtx);
+        auto it = shard.by_login.find(login);
+        if ( it == shard.by_login.end() ) return { };
+
+        return WithoutCredentials(shard.rows.at(it->second));
+    }
+
+    std::optional<User> MemoryUserStorage::ChangeRole(std::string login, UserRole new_role) {
+        Shard& shard = ShardOf(login);
+
+        std::unique_lock<std::shared_mutex> lck(shard.mtx);
+        auto it = shard.by_login.find(login);
+        if ( it == shard.by_login.end() ) return { };
+
+        User& user = shard.rows.at(it->second);
+        user.role_ = new_role;
+        return WithoutCredentials(user);
+    }
+
+    std::optional<User> MemoryUserStorage::AuthUser(std::string login, std::string password) {
+        const Shard& shard = ShardOf(login);
+
+        std::shared_lock<std::shared_mutex> lck(shard.mtx);
+        auto it = shard.by_login.find(login);
+        if ( it == shard.by_login.end() ) return { };
+
+        const User& user = shard.rows.at(it->second);
+        if ( user.password_ != password ) return { };
+
+        return WithoutCredentials(user);
+    }
+
+    void MemoryUserStorage::InsertBatch(std::vector<User>& users) {
+        if ( users.empty() ) return;
+
+        /* Как и многострочный INSERT, пачка пишется в шард первого логина целиком или не пишется вовсе */
+        size_t shard_id = Database::UserShardingHint(users.front().login_).shard_id;
+        Shard& shard = shards_.at(shard_id);
+
+        std::unique_lock<std::shared_mutex> lck(shard.mtx);
+
+        std::unordered_set<std::string> logins;
+        for ( const User& user : users ) {
+            if ( shard.by_login.count(user.login_) > 0 || !logins.insert(user.login_).second ) {
+                throw exceptions::Conflict("Duplicate entry '" + user.login_ + "' for key 'login_uq'");
+            }
+        }
+
+        for ( User& user : users ) {
+            long db_id = shard.next_id++;
+            user.id_ = DB_ID_Index::FromDBID(db_id, shard_id).GetExternalID();
+            shard.by_login.emplace(user.login_, db_id);
+            shard.rows.emplace(db_id, user);
+        }
+    }
+
+    MemoryUserStorage::Shard& MemoryUserStorage::ShardOf(const std::string& login) {
+        return shards_.at(Database::UserShardingHint(login).shard_id);
+    }
+
+} // namespace database
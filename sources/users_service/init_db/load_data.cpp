@@ -11,6 +11,8 @@
 #include <Poco/JSON/Parser.h>
 #include <Poco/Dynamic/Var.h>
 
+#include "../database/include/database/sharding.h"
+
 #define TABLE_NAME "Users"
 #define CREATE_TABLE_REQUEST \
     "CREATE TABLE IF NOT EXISTS `" TABLE_NAME "` "                  \
@@ -24,6 +26,7 @@
     "`password` "    "VARCHAR(256) " "NOT NULL,"                    \
     "`role`     "    "VARCHAR(32)  " "NOT NULL,"                    \
     "PRIMARY KEY (`id`), "                                          \
+    "UNIQUE KEY `login_uq` (`login`), "                             \
     "KEY `fn` (`first_name`),"                                      \
     "KEY `ln` (`last_name`));"
 
@@ -32,6 +35,18 @@
     "(first_name, last_name, middle_name, email, gender, login, password, role) " \
     "VALUES(?, ?, ?, ?, ?, ?, ?, ?)"
 
+namespace {
+
+    /* ER_DUP_ENTRY */
+    constexpr const int kDuplicateEntryError = 1062;
+
+    /* Старые версии Poco кладут код ошибки MySQL только в текст сообщения */
+    bool IsDuplicateEntry(const Poco::Data::MySQL::StatementException& e) {
+        return e.code() == kDuplicateEntryError || e.message().find("Duplicate entry") != std::string::npos;
+    }
+
+} // namespace [ Functions ]
+
 int main() {
 
     Poco::Data::MySQL::Connector::registerConnector();
@@ -65,14 +80,19 @@ int main() {
     std::cout << "session created" << std::endl;
     try
     {
-        Poco::Data::Statement create_stmt(session);
-        create_stmt << CREATE_TABLE_REQUEST;
-        create_stmt.execute();
-        std::cout << "table created" << std::endl;
-
-        Poco::Data::Statement truncate_stmt(session);
-        truncate_stmt << "TRUNCATE TABLE `" TABLE_NAME "`;";
-        truncate_stmt.execute();
+        /* Таблица создается и очищается в каждом шарде */
+        for ( size_t shard = 0; shard < database::kUserShards; shard++ ) {
+            std::string hint = database::MakeShardingHint(shard).hint;
+
+            Poco::Data::Statement create_stmt(session);
+            create_stmt << CREATE_TABLE_REQUEST << " " << hint;
+            create_stmt.execute();
+            std::cout << "table created on shard " << shard << std::endl;
+
+            Poco::Data::Statement truncate_stmt(session);
+            truncate_stmt << "TRUNCATE TABLE `" TABLE_NAME "` " << hint;
+            truncate_stmt.execute();
+        }
 
         // https://www.onlinedatagenerator.com/
         std::string json;
@@ -88,6 +108,7 @@ int main() {
         Poco::JSON::Array::Ptr arr = result.extract<Poco::JSON::Array::Ptr>();
 
         size_t i{0};
+        size_t skipped{0};
         for (i = 0; i < arr->size(); ++i)
         {
             Poco::JSON::Object::Ptr object = arr->getObject(i);
@@ -101,8 +122,9 @@ int main() {
             std::string password = "HelloWorld00";
             std::string role = "user";
 
+            /* Шард выбирается по логину так же, как при регистрации через сервис */
             Poco::Data::Statement insert(session);
-            insert << INSERT_USER_REQUEST,
+            insert << INSERT_USER_REQUEST << " " << database::LoginShardingHint(login).hint,
                     Poco::Data::Keywords::use(first_name),
                     Poco::Data::Keywords::use(last_name),
                     Poco::Data::Keywords::use(middle_name),
@@ -112,11 +134,20 @@ int main() {
                     Poco::Data::Keywords::use(password),
                     Poco::Data::Keywords::use(role);
 
-            insert.execute();
+            /* В сгенерированных данных встречаются повторяющиеся email, а login совпадает с email:
+             * повторы пропускаются, остальные ошибки прерывают загрузку */
+            try {
+                insert.execute();
+            } catch (Poco::Data::MySQL::StatementException &e) {
+                if ( !IsDuplicateEntry(e) ) throw;
+                skipped++;
+                std::cout << "Skipped duplicate login: " << login << std::endl;
+                continue;
+            }
             std::cout << "Exeuted: " << i  << " / " << arr->size() << std::endl;
         }
 
-        std::cout << "Inserted " << i << " records" << std::endl;
+        std::cout << "Inserted " << i - skipped << " records, skipped " << skipped << " duplicates" << std::endl;
 
     }
     catch (Poco::Data::MySQL::ConnectionException &e)
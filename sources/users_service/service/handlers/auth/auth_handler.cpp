@@ -7,6 +7,8 @@
 #include "database/database.h"
 #include "database/user.h"
 
+#include "../../../../shared/errors.h"
+
 #include <string>
 #include <vector>
 
@@ -48,6 +50,10 @@ namespace handler {
                 SetBadRequestResponse(response, "Service unsupported this method for /auth URI.");
             }
 
+        } catch (const exceptions::DeadlineExceeded& e) {
+
+            SetGatewayTimeoutResponse(response, e.what());
+
         } catch (const std::exception &e) {
 
             std::string error_desc{"Server end of work with exception: "};
@@ -57,6 +63,21 @@ namespace handler {
         }
     }
 
+    std::optional<std::pair<std::string, std::string>> AuthHandler::ParseBasicCredentials(const std::string& base64) {
+        std::stringstream decode_stream;
+        decode_stream << base64;
+        Poco::Base64Decoder base64_decoder{decode_stream};
+
+        std::string decoded;
+        base64_decoder >> decoded;
+
+        auto credentials = SplitString(decoded, ":");
+        if ( credentials.size() != 2 ) {
+            return std::nullopt;
+        }
+        return std::make_pair(std::move(credentials[0]), std::move(credentials[1]));
+    }
+
     void
     AuthHandler::HandleGetRequest(Poco::Net::HTTPServerRequest &request, Poco::Net::HTTPServerResponse &response) {
 
@@ -73,19 +94,12 @@ namespace handler {
                 return;
             }
 
-            std::stringstream decode_stream;
-            decode_stream << base64;
-            Poco::Base64Decoder base64_decoder{decode_stream};
-
-            std::string decoded;
-            base64_decoder >> decoded;
-
-            auto credentials = SplitString(decoded, ":");
-            if ( credentials.size() != 2 ) {
+            auto credentials = ParseBasicCredentials(base64);
+            if ( !credentials.has_value() ) {
                 SetBadRequestResponse(response, "Invalid auth credentials.");
                 return;
             }
-            auto user = database::User::AuthUser(credentials[0], credentials[1]);
+            auto user = database::User::AuthUser(credentials->first, credentials->second);
             if ( user.has_value() ) {
                 request_sender = user.value();
             } else {
@@ -108,8 +122,7 @@ namespace handler {
         root->set("id", std::to_string(request_sender.GetID()));
         root->set("user_role", request_sender.GetRole().ToString());
 
-        std::ostream &ostr = response.send();
-        Poco::JSON::Stringifier::stringify(root, ostr);
+        SendJSON(request, response, root);
 
     }
 
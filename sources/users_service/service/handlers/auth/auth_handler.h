@@ -3,6 +3,10 @@
 
 #include "../interface/i_request_handler.h"
 
+#include <optional>
+#include <string>
+#include <utility>
+
 namespace handler {
 
     class AuthHandler : public IRequestHandler {
@@ -13,6 +17,9 @@ namespace handler {
 
         void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response) override;
 
+        /* Пара (login, password) из base64 части заголовка Authorization: Basic */
+        static std::optional<std::pair<std::string, std::string>> ParseBasicCredentials(const std::string& base64);
+
     private:
 
         void HandleGetRequest(HTTPServerRequest& request, HTTPServerResponse& response);
@@ -2,6 +2,10 @@
 
 #include <Poco/JSON/Object.h>
 
+#include "../../../../shared/etag.h"
+#include "../../../../shared/response_compression.h"
+
+#include <sstream>
 #include <utility>
 
 
@@ -24,6 +28,30 @@ namespace handler {
         return type_;
     }
 
+    /**
+     * @brief Заполнение NotModified(304) ответа на условный GET.
+     * @param etag - ETag текущего представления ресурса.
+     * @return true, если ответ 304 отправлен и тело передавать не нужно.
+     */
+    bool IRequestHandler::SetNotModifiedResponse(HTTPServerRequest &request, HTTPServerResponse &response,
+                                                 const std::string &etag) {
+        response.set("ETag", etag);
+        response.set("Cache-Control", "private, no-cache");
+
+        if ( !request.has("If-None-Match") ) return false;
+
+        std::optional<std::string> matched = search_service::MatchIfNoneMatch(request.get("If-None-Match"), etag);
+        if ( !matched.has_value() ) return false;
+
+        /* 304 подтверждает представление клиента вместе с его кодировкой */
+        response.set("ETag", *matched);
+        response.setStatus(Poco::Net::HTTPResponse::HTTPStatus::HTTP_NOT_MODIFIED);
+        response.setChunkedTransferEncoding(false);
+        response.setContentLength(0);
+        response.send();
+        return true;
+    }
+
     /**
      * @brief Заполнение BadRequest(400) формы ответа
      * @param response HTML ответ для записи.
@@ -126,6 +154,26 @@ namespace handler {
     }
 
 
+    /**
+     * @brief Заполнение Conflict(409) формы ответа
+     * @param response HTML ответ для записи.
+     * @param description - описание ошибки.
+     */
+    void IRequestHandler::SetConflictResponse(Poco::Net::HTTPServerResponse &response, const std::string &description) {
+        response.setStatus(Poco::Net::HTTPResponse::HTTPStatus::HTTP_CONFLICT);
+        response.setChunkedTransferEncoding(true);
+        response.setContentType("application/json");
+        Poco::JSON::Object::Ptr root = new Poco::JSON::Object();
+        root->set("type", "/errors/conflict_error");
+        root->set("title", "Conflict error.");
+        root->set("status", Poco::Net::HTTPResponse::HTTP_REASON_CONFLICT);
+        root->set("detail", description);
+        root->set("instance", this->Instance());
+
+        std::ostream &ostr = response.send();
+        Poco::JSON::Stringifier::stringify(root, ostr);
+    }
+
     /**
      * @brief Заполнение InternalError(500) формы ответа
      * @param response HTML ответ для записи.
@@ -146,4 +194,34 @@ namespace handler {
         Poco::JSON::Stringifier::stringify(root, ostr);
     }
 
+    /**
+     * @brief Заполнение GatewayTimeout(504) формы ответа
+     * @param response HTML ответ для записи.
+     * @param description - описание ошибки.
+     */
+    void IRequestHandler::SetGatewayTimeoutResponse(Poco::Net::HTTPServerResponse &response,
+                                                    const std::string &description) {
+        response.setStatus(Poco::Net::HTTPResponse::HTTPStatus::HTTP_GATEWAY_TIMEOUT);
+        response.setChunkedTransferEncoding(true);
+        response.setContentType("application/json");
+        Poco::JSON::Object::Ptr root = new Poco::JSON::Object();
+        root->set("type", "/errors/gateway_timeout");
+        root->set("title", "Gateway timeout.");
+        root->set("status", Poco::Net::HTTPResponse::HTTP_REASON_GATEWAY_TIMEOUT);
+        root->set("detail", description);
+        root->set("instance", this->Instance());
+        std::ostream &ostr = response.send();
+        Poco::JSON::Stringifier::stringify(root, ostr);
+    }
+
+    /**
+     * @brief Отправка JSON тела ответа.
+     * @details Большие ответы сжимаются, если клиент прислал подходящий Accept-Encoding.
+     */
+    void IRequestHandler::SendJSON(HTTPServerRequest &request, HTTPServerResponse &response, const Poco::Dynamic::Var &json) {
+        std::ostringstream body;
+        Poco::JSON::Stringifier::stringify(json, body);
+        search_service::ResponseCompression::Instance().Send(request, response, body.str());
+    }
+
 } // namespace handler
\ No newline at end of file
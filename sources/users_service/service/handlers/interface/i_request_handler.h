@@ -6,6 +6,7 @@
 #include "Poco/Net/HTTPRequestHandler.h"
 #include "Poco/Net/HTTPServerRequest.h"
 #include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Dynamic/Var.h"
 
 using Poco::Net::HTTPRequestHandler;
 using Poco::Net::HTTPServerRequest;
@@ -29,6 +30,9 @@ namespace handler {
 
         std::string& GetFormat() noexcept;
 
+        /* 304. Выставляет ETag и отвечает 304, если If-None-Match запроса совпал с ним. */
+        bool SetNotModifiedResponse(HTTPServerRequest& request, HTTPServerResponse& response, const std::string& etag);
+
         /* 400 */
         void SetBadRequestResponse(HTTPServerResponse& response, const std::string& description);
 
@@ -44,9 +48,18 @@ namespace handler {
         /* 406 */
         void SetNotAcceptableResponse(HTTPServerResponse& response, const std::string& description);
 
+        /* 409 */
+        void SetConflictResponse(HTTPServerResponse& response, const std::string& description);
+
         /* 500 */
         void SetInternalErrorResponse(HTTPServerResponse& response, const std::string& description);
 
+        /* 504. Данные не получены к сроку запроса. */
+        void SetGatewayTimeoutResponse(HTTPServerResponse& response, const std::string& description);
+
+        /* Отправка JSON тела ответа со сжатием по Accept-Encoding */
+        void SendJSON(HTTPServerRequest& request, HTTPServerResponse& response, const Poco::Dynamic::Var& json);
+
 
     private:
         std::string format_;
@@ -11,6 +11,9 @@
 #include "database/database.h"
 #include "database/user.h"
 
+#include "../../../../shared/errors.h"
+#include "../../../../shared/request_deadline.h"
+
 #include <iostream>
 #include <string>
 #include <vector>
@@ -30,6 +33,10 @@ namespace handler {
                 SetBadRequestResponse(response, "Service unsupported this method for /search URI.");
             }
 
+        } catch (const exceptions::DeadlineExceeded& e) {
+
+            SetGatewayTimeoutResponse(response, e.what());
+
         } catch (const std::exception& e) {
 
             std::string error_desc{ "Server end of work with exception: " };
@@ -57,8 +64,13 @@ namespace handler {
             std::string auth_token = schema + " " + base64;
             std::string url = "http://127.0.0.1:8080/auth";
 
+            search_service::RequestDeadline::Check("auth request");
+
             Poco::URI uri(url);
             Poco::Net::HTTPClientSession s(uri.getHost(), uri.getPort());
+            if ( auto remaining = search_service::RequestDeadline::Remaining() ) {
+                s.setTimeout(Poco::Timespan(static_cast<Poco::Timespan::TimeDiff>(*remaining) * Poco::Timespan::MILLISECONDS));
+            }
             Poco::Net::HTTPRequest auth_request(Poco::Net::HTTPRequest::HTTP_GET, uri.toString());
             auth_request.setVersion(Poco::Net::HTTPMessage::HTTP_1_1);
             auth_request.setContentType("application/json");
@@ -66,6 +78,7 @@ namespace handler {
             auth_request.setProxyCredentials(schema, base64);
             auth_request.set("Accept", "application/json");
             auth_request.setKeepAlive(true);
+            search_service::RequestDeadline::Propagate(auth_request);
 
             s.sendRequest(auth_request);
 
@@ -108,21 +121,25 @@ namespace handler {
         std::string first_name = form.get("first_name");
         std::string last_name  = form.get("last_name");
 
-        std::vector<database::User> users = database::User::Search(first_name, last_name);
-        if ( users.empty() ) {
+        database::UserSearchResult found = database::User::Search(first_name, last_name);
+        if ( found.users.empty() && !found.partial ) {
             SetNotFoundResponse(response, "Users provided by mask not found.");
             return;
         }
 
         Poco::JSON::Array arr;
-        for (const auto& s : users)
+        for (const auto& s : found.users)
             arr.add(s.ToJSON());
 
+        /* Часть шардов не ответила в срок, клиент получает то, что успели найти */
+        if ( found.partial ) {
+            response.set("X-Partial-Results", "true");
+        }
+
         response.setStatus(Poco::Net::HTTPResponse::HTTP_OK);
         response.setChunkedTransferEncoding(true);
         response.setContentType("application/json");
-        std::ostream &ostr = response.send();
-        Poco::JSON::Stringifier::stringify(arr, ostr);
+        SendJSON(request, response, arr);
     }
 
 } // namespace handler
\ No newline at end of file
@@ -12,6 +12,10 @@
 #include "database/user_role.h"
 #include "database/cache.h"
 
+#include "../../../../shared/etag.h"
+#include "../../../../shared/errors.h"
+#include "../../../../shared/request_deadline.h"
+
 #include <iostream>
 #include <regex>
 
@@ -208,6 +212,11 @@ namespace handler {
                 return;
             }
 
+        /* Шарды не ответили к сроку запроса */
+        } catch (const exceptions::DeadlineExceeded& e) {
+            SetGatewayTimeoutResponse(response, e.what());
+            return;
+
         /* При возникновении исключения порождается ответ INTERNAL_ERROR[500] с описанием ошибки */
         } catch (const std::exception& e) {
             std::string error_desc = "Server end of work with exception: ";
@@ -301,16 +310,14 @@ namespace handler {
         user.Password() = password;
         user.Role() = database::UserRole(database::UserRole::User);
 
-        /* Проверка наличия пользователя с идентичным логином в системе */
-        auto user_with_current_login = database::User::SearchByLogin(login);
-        if ( user_with_current_login.has_value() ) {
-            SetNotAcceptableResponse(response, "User with current login is exists.");
+        /* Уникальность логина обеспечивает индекс в БД: отдельная проверка перед вставкой не нужна */
+        try {
+            user.InsertToDatabase();
+        } catch (const exceptions::Conflict&) {
+            SetConflictResponse(response, "User with current login is exists.");
             return;
         }
 
-        /* Если пользователя с идентичным логином нет, то вставляем в БД */
-        user.InsertToDatabase();
-
         /* Если все успешно отправляем ответ */
         response.setStatus(Poco::Net::HTTPResponse::HTTPStatus::HTTP_OK);
         response.setChunkedTransferEncoding(true);
@@ -321,8 +328,7 @@ namespace handler {
         root->set("status", Poco::Net::HTTPResponse::HTTP_REASON_OK);
         root->set("instance", "/user");
         root->set("id", std::to_string(user.GetID()));
-        std::ostream &ostr = response.send();
-        Poco::JSON::Stringifier::stringify(root, ostr);
+        SendJSON(request, response, root);
 
     }
 
@@ -390,15 +396,18 @@ namespace handler {
             user = database::User::FromCacheByID(id);
 
         if ( !user.has_value() ) {
-            user = database::User::SearchByID(id);
+            user = use_cache ? database::User::SearchByIDToCache(id) : database::User::SearchByID(id);
 
             if ( !user.has_value() ) {
                 SetNotFoundResponse(response, "User with requested id not found.");
                 return;
             }
+        }
 
-            if ( use_cache )
-                user->SaveToCache();
+        /* При попадании в кэш условный запрос подтверждается без обращения к MySQL */
+        auto json_user = user->ToJSON();
+        if ( SetNotModifiedResponse(request, response, search_service::MakeETag(json_user)) ) {
+            return;
         }
 
         response.setStatus(Poco::Net::HTTPResponse::HTTPStatus::HTTP_OK);
@@ -409,10 +418,8 @@ namespace handler {
         root->set("title", "OK");
         root->set("status", Poco::Net::HTTPResponse::HTTP_REASON_OK);
         root->set("instance", "/user");
-        auto json_user = user->ToJSON();
         root->set("user", json_user);
-        std::ostream &ostr = response.send();
-        Poco::JSON::Stringifier::stringify(root, ostr);
+        SendJSON(request, response, root);
 
     }
 
@@ -468,8 +475,7 @@ namespace handler {
         root->set("instance", "/user");
         root->set("id", std::to_string(changed_user->GetID()));
 
-        std::ostream &ostr = response.send();
-        Poco::JSON::Stringifier::stringify(root, ostr);
+        SendJSON(request, response, root);
 
     }
 
@@ -487,8 +493,13 @@ namespace handler {
         std::string auth_token = schema + " " + base64;
         std::string url = "http://127.0.0.1:8080/auth";
 
+        search_service::RequestDeadline::Check("auth request");
+
         Poco::URI uri(url);
         Poco::Net::HTTPClientSession s(uri.getHost(), uri.getPort());
+        if ( auto remaining = search_service::RequestDeadline::Remaining() ) {
+            s.setTimeout(Poco::Timespan(static_cast<Poco::Timespan::TimeDiff>(*remaining) * Poco::Timespan::MILLISECONDS));
+        }
         Poco::Net::HTTPRequest auth_request(Poco::Net::HTTPRequest::HTTP_GET, uri.toString());
         auth_request.setVersion(Poco::Net::HTTPMessage::HTTP_1_1);
         auth_request.setContentType("application/json");
@@ -496,6 +507,7 @@ namespace handler {
         auth_request.setProxyCredentials(schema, base64);
         auth_request.set("Accept", "application/json");
         auth_request.setKeepAlive(true);
+        search_service::RequestDeadline::Propagate(auth_request);
 
         s.sendRequest(auth_request);
 
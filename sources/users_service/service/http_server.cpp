@@ -1,9 +1,14 @@
 #include "http_server.h"
 
 #include "database/database.h"
+#include "database/async_database.h"
 #include "database/user.h"
+#include "database/user_storage.h"
 #include "database/cache.h"
+#include "database/registration_batcher.h"
+#include "database/refresh_ahead.h"
 
+#include <future>
 #include <iostream>
 
 namespace search_service {
@@ -37,28 +42,161 @@ namespace search_service {
             config_ = std::make_shared<search_service::Config>(args[0]);
             auto network_config = config_->GetNetworkConfig();
             auto caching_config = config_->GetCachingConfig();
+            auto database_config = config_->GetDatabaseConfig();
 
-            if ( !database::Database::Instance().IsConnected() ) {
-                database::Database::Instance().BindConfigure(config_->GetDatabaseConfig());
-                bool result = database::Database::Instance().TryConnect();
-                if ( !result ) {
-                    std::cerr << "Failed connect to database." << std::endl;
-                    return EXIT_DATAERR;
+            if ( database_config->IsMemoryStorage() ) {
+                database::UserStorage::Use(std::make_unique<database::MemoryUserStorage>());
+            } else {
+                database::UserStorage::Use(std::make_unique<database::MySqlUserStorage>(database_config->GetPartialSearch()));
+
+                if ( !database::Database::Instance().IsConnected() ) {
+                    database::Database::Instance().BindConfigure(database_config);
+                    bool result = database::Database::Instance().TryConnect();
+                    if ( !result ) {
+                        std::cerr << "Failed connect to database." << std::endl;
+                        return EXIT_DATAERR;
+                    }
                 }
+
+                database::AsyncDatabase::Instance().BindConfigure(database_config);
+                database::AsyncDatabase::Instance().Start();
             }
 
+            database::RegistrationBatcher::Instance().Configure(
+                    database_config->GetInsertBatchWindow(),
+                    database_config->GetInsertBatchMaxSize()
+            );
+            database::RegistrationBatcher::Instance().Start();
+
             database::User::Init();
-            database::Cache::Get()->Init(
-                    caching_config->GetHost(),
-                    caching_config->GetPort(),
-                    caching_config->GetExpiration()
+            std::future<size_t> snapshot_loaded;
+            if ( caching_config->GetEnabled() ) {
+                CircuitBreaker::Configure(kCacheBreaker, CircuitBreakerOptions{
+                        caching_config->GetBreakerFailures(),
+                        caching_config->GetBreakerOpenMs(),
+                        caching_config->GetTimeoutMs()
+                });
+
+                auto cache_backend = MakeCacheBackend(
+                        caching_config->GetBackend(),
+                        caching_config->GetHost(),
+                        caching_config->GetPort(),
+                        caching_config->GetPoolSize(),
+                        caching_config->GetMemoryMaxEntries()
+                );
+                /* Кэш в памяти процесса не разделяется с другими экземплярами, рассылать инвалидации некому */
+                bool shared_cache = cache_backend->IsShared();
+
+                database::Cache::Get()->Init(
+                        std::move(cache_backend),
+                        caching_config->GetExpiration(),
+                        caching_config->GetLocalExpiration(),
+                        caching_config->GetLocalMaxEntries()
+                );
+                if ( shared_cache ) {
+                    InvalidationBus::Get()->Start(
+                            caching_config->GetHost(),
+                            caching_config->GetPort(),
+                            caching_config->GetInvalidationChannel(),
+                            [](long id) { database::Cache::Get()->Invalidate(id); },
+                            []() {
+                                database::Cache::Get()->InvalidateAll();
+                                return true;
+                            }
+                    );
+                }
+
+                database::RefreshAhead::Instance().Configure(
+                        caching_config->GetRefreshAheadSec(),
+                        caching_config->GetRefreshMinHits(),
+                        caching_config->GetRefreshQueueSize(),
+                        caching_config->GetLocalMaxEntries()
+                );
+                database::RefreshAhead::Instance().Start();
+
+                if ( !caching_config->GetSnapshotPath().empty() ) {
+                    snapshot_loaded = database::Cache::Get()->LoadSnapshot(
+                            caching_config->GetSnapshotPath(),
+                            caching_config->GetSnapshotMmap()
+                    );
+                }
+            }
+
+            auto server_config = config_->GetServerConfig();
+
+            HTTPServerParams::Ptr params = new HTTPServerParams;
+            params->setMaxThreads(static_cast<int>(server_config->GetMaxThreads()));
+            params->setMaxQueued(static_cast<int>(server_config->GetMaxQueued()));
+            params->setThreadIdleTime(Poco::Timespan(server_config->GetThreadIdleTime(), 0));
+            params->setKeepAlive(server_config->GetKeepAlive());
+            params->setMaxKeepAliveRequests(static_cast<int>(server_config->GetMaxKeepAliveRequests()));
+            params->setKeepAliveTimeout(Poco::Timespan(server_config->GetKeepAliveTimeout(), 0));
+            params->setTimeout(Poco::Timespan(server_config->GetTimeout(), 0));
+
+            AdmissionControl::Instance().Configure(
+                    server_config->GetMaxThreads(),
+                    server_config->GetMaxQueueWait(),
+                    server_config->GetMaxPoolWait()
             );
 
-            ServerSocket svs(Poco::Net::SocketAddress(network_config->GetIP(), network_config->GetPort()));
-            HTTPServer srv(new HTTPRequestFactory(DateTimeFormat::SORTABLE_FORMAT), svs, new HTTPServerParams);
-            srv.start();
-            waitForTerminationRequest();
-            srv.stop();
+            RequestDeadline::Instance().Configure(server_config->GetRequestTimeoutMs());
+
+            ResponseCompression::Instance().Configure(
+                    server_config->GetCompression(),
+                    server_config->GetCompressionMinSize(),
+                    server_config->GetCompressionLevel()
+            );
+
+            /* Горячие записи прошлого запуска загружаются до приёма запросов */
+            if ( snapshot_loaded.valid() ) snapshot_loaded.wait();
+
+            ServerSocket svs;
+            svs.bind(Poco::Net::SocketAddress(network_config->GetIP(), network_config->GetPort()),
+                     server_config->GetReuseAddress(),
+                     server_config->GetReusePort());
+            svs.listen(static_cast<int>(server_config->GetBacklog()));
+
+            AdmissionControl::Instance().BindPoolWaitProbe([]() {
+                return database::Database::Instance().GetPoolWaitTime();
+            });
+
+            if ( server_config->IsEventLoopMode() ) {
+                EventLoopServer srv(new HTTPRequestFactory(DateTimeFormat::SORTABLE_FORMAT, server_config->GetRetryAfter()),
+                                    svs, params, server_config->GetReactorThreads());
+
+                AdmissionControl::Instance().BindQueueProbe([&srv]() { return srv.queuedConnections(); });
+
+                srv.start();
+                waitForTerminationRequest();
+                srv.stop();
+            } else {
+                Poco::ThreadPool thread_pool(
+                        static_cast<int>(server_config->GetMinThreads()),
+                        static_cast<int>(server_config->GetMaxThreads()),
+                        static_cast<int>(server_config->GetThreadIdleTime())
+                );
+
+                HTTPServer srv(new HTTPRequestFactory(DateTimeFormat::SORTABLE_FORMAT, server_config->GetRetryAfter()),
+                               thread_pool, svs, params);
+
+                AdmissionControl::Instance().BindQueueProbe([&srv]() { return srv.queuedConnections(); });
+
+                srv.start();
+                waitForTerminationRequest();
+                srv.stop();
+            }
+            AdmissionControl::Instance().UnbindProbes();
+            if ( caching_config->GetEnabled() && !caching_config->GetSnapshotPath().empty() ) {
+                database::Cache::Get()->SaveSnapshot(
+                        caching_config->GetSnapshotPath(),
+                        caching_config->GetSnapshotMaxEntries()
+                );
+            }
+            database::RefreshAhead::Instance().Stop();
+            database::RegistrationBatcher::Instance().Stop();
+            InvalidationBus::Get()->Stop();
+            database::Database::Instance().Shutdown();
+            database::AsyncDatabase::Instance().Stop();
         }
         return Application::EXIT_OK;
     }